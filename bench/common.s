@@ -0,0 +1,131 @@
+; Copyright (c) 2026 Bastiaan van der Plaat
+; SPDX-License-Identifier: MIT
+
+; Shared startup and reporting for the benchmarks. Each benchmark is a boot
+; ROM image: it calls bench_init, brackets every kernel with bench_begin and
+; bench_end, and finishes with bench_exit. bench_end prints one line per
+; kernel over the UART and on the text display:
+;   <name> cycles <decimal> instret <decimal> check <hex>
+; The check value is chosen by the kernel so wrong results show up too.
+
+; Set up the stack, UART rings, trap handler, scroll origin, text RAM and
+; cursor the same way as boot/boot.s
+bench_init:
+    lui sp, %hi(STACK_TOP)
+    addi sp, sp, %lo(STACK_TOP)
+    li t0, TX_HEAD
+    sw zero, 0(t0)
+    sw zero, 4(t0)
+    sw zero, 8(t0)
+    sw zero, 12(t0)
+    la t0, trap_handler
+    csrw mtvec, t0
+    li t0, UART_IRQ_ENABLE
+    addi t1, zero, 1
+    sw t1, 0(t0)
+    li t0, 0x800               ; MEIE
+    csrs mie, t0
+    csrsi mstatus, 8           ; MIE
+
+    li t0, VIDEO_ORIGIN
+    sw zero, 0(t0)
+    li t0, VIDEO_BLIT_DST
+    sw zero, 0(t0)
+    li t0, VIDEO_BLIT_LEN
+    li t1, VIDEO_WORDS
+    sw t1, 0(t0)
+    li t0, VIDEO_BLIT_FILL
+    li t1, VIDEO_BLANK
+    sw t1, 0(t0)
+    li t0, VIDEO_BLIT_CTRL
+    addi t1, zero, BLIT_FILL
+    sw t1, 0(t0)
+bench_init_wait:
+    lw t1, 0(t0)
+    andi t1, t1, 1
+    bne t1, zero, bench_init_wait
+    li s2, VIDEO_BASE          ; cursor cell address
+    addi s3, zero, 0           ; cursor column
+    addi s4, zero, 0           ; cursor row
+    ret
+
+; Start measuring
+bench_begin:
+    li t0, BENCH_START
+    rdinstret t2
+    rdcycle t1
+    sw t1, 0(t0)
+    sw t2, 4(t0)
+    ret
+
+; Stop measuring and print the kernel named by a0 with check value a1.
+; Clobbers s5-s8.
+bench_end:
+    rdcycle t1
+    rdinstret t2
+    li t0, BENCH_START
+    lw t3, 0(t0)
+    lw t4, 4(t0)
+    sub t1, t1, t3
+    sub t2, t2, t4
+    sw t1, 0(t0)
+    sw t2, 4(t0)
+    mv s7, ra
+    mv s8, a1
+    jal ra, print_string
+    la a0, str_bench_cycles
+    jal ra, print_string
+    li t0, BENCH_START
+    lw a0, 0(t0)
+    jal ra, print_dec
+    la a0, str_bench_instret
+    jal ra, print_string
+    li t0, BENCH_START
+    lw a0, 4(t0)
+    jal ra, print_dec
+    la a0, str_bench_check
+    jal ra, print_string
+    mv a0, s8
+    jal ra, print_hex
+    la a0, str_crlf
+    jal ra, print_string
+    mv ra, s7
+    ret
+
+; Print a0 as an unsigned decimal number
+print_dec:
+    li t0, BENCH_DEC_END
+    sb zero, 0(t0)
+    addi t1, zero, 10
+print_dec_loop:
+    addi t0, t0, -1
+    remu t2, a0, t1
+    divu a0, a0, t1
+    addi t2, t2, 48            ; '0'
+    sb t2, 0(t0)
+    bne a0, zero, print_dec_loop
+    mv a0, t0
+    j print_string
+
+; Print the end marker the harness waits for and sleep while the UART drains
+bench_exit:
+    la a0, str_bench_done
+    jal ra, print_string
+bench_halt:
+    wfi
+    j bench_halt
+
+.include "../boot/console.s"
+.include "../boot/trap.s"
+.include "../boot/string.s"
+
+str_bench_cycles:
+    .asciz " cycles "
+str_bench_instret:
+    .asciz " instret "
+str_bench_check:
+    .asciz " check "
+str_bench_done:
+    .asciz "bench done\r\n"
+str_crlf:
+    .asciz "\r\n"
@@ -0,0 +1,140 @@
+; Copyright (c) 2026 Bastiaan van der Plaat
+; SPDX-License-Identifier: MIT
+
+; CoreMark-style kernel mix: every iteration sums and reverses a linked list,
+; accumulates an 8x8 matrix product and folds both results into a CRC-16.
+
+.include "../boot/consts.s"
+
+.equ ITERATIONS,      8
+.equ LIST_NODES,      32
+.equ LIST_BASE,       0x20001000   ; nodes of two words: next, value
+.equ MATRIX_A,        0x20001200
+.equ MATRIX_B,        0x20001300
+.equ MATRIX_C,        0x20001400
+.equ MATRIX_BYTES,    256
+
+_start:
+    jal ra, bench_init
+
+    ; Link the list nodes in address order
+    li t0, LIST_BASE
+    addi t1, zero, 0
+    addi t2, zero, LIST_NODES
+list_build:
+    addi t3, t0, 8
+    sw t3, 0(t0)
+    slli t4, t1, 3
+    sub t4, t4, t1
+    xori t4, t4, 0x55          ; value = i * 7 ^ 0x55
+    sw t4, 4(t0)
+    mv t0, t3
+    addi t1, t1, 1
+    blt t1, t2, list_build
+    sw zero, -8(t0)
+    li s9, LIST_BASE           ; list head
+
+    ; A[i] = i + 1, B[i] = 64 - i, C = 0
+    li t0, MATRIX_A
+    addi t1, zero, 0
+    addi t2, zero, 64
+matrix_build:
+    addi t3, t1, 1
+    sw t3, 0(t0)
+    sub t3, t2, t1
+    sw t3, MATRIX_BYTES(t0)
+    addi t0, t0, 4
+    addi t1, t1, 1
+    blt t1, t2, matrix_build
+    li a0, MATRIX_C
+    addi a1, zero, 0
+    li a2, MATRIX_BYTES
+    jal ra, memset
+
+    jal ra, bench_begin
+    addi s0, zero, ITERATIONS
+    addi s1, zero, 0           ; CRC
+iteration:
+    ; Sum the list values, then reverse the list in place
+    mv t0, s9
+    addi t1, zero, 0
+list_sum:
+    lw t2, 4(t0)
+    add t1, t1, t2
+    lw t0, 0(t0)
+    bne t0, zero, list_sum
+    mv t0, s9
+    addi t2, zero, 0
+list_reverse:
+    lw t3, 0(t0)
+    sw t2, 0(t0)
+    mv t2, t0
+    mv t0, t3
+    bne t0, zero, list_reverse
+    mv s9, t2
+    mv a0, t1
+    jal ra, crc16
+
+    ; C += A * B
+    li a2, MATRIX_A
+    li a3, MATRIX_B
+    li a4, MATRIX_C
+    addi t0, zero, 0           ; row offset
+matrix_row:
+    addi t1, zero, 0           ; column offset
+matrix_col:
+    add a5, a2, t0
+    add a6, a3, t1
+    addi t2, zero, 8
+    addi t3, zero, 0
+matrix_dot:
+    lw t4, 0(a5)
+    lw t5, 0(a6)
+    mul t4, t4, t5
+    add t3, t3, t4
+    addi a5, a5, 4
+    addi a6, a6, 32
+    addi t2, t2, -1
+    bne t2, zero, matrix_dot
+    add a7, a4, t0
+    add a7, a7, t1
+    lw t4, 0(a7)
+    add t4, t4, t3
+    sw t4, 0(a7)
+    addi t1, t1, 4
+    addi t2, zero, 32
+    blt t1, t2, matrix_col
+    addi t0, t0, 32
+    addi t2, zero, MATRIX_BYTES
+    blt t0, t2, matrix_row
+    lw a0, 252(a4)
+    jal ra, crc16
+
+    addi s0, s0, -1
+    bne s0, zero, iteration
+
+    la a0, str_coremark
+    mv a1, s1
+    jal ra, bench_end
+    j bench_exit
+
+; Fold the low 16 bits of a0 into the CRC-16 in s1, one bit at a time
+crc16:
+    addi t5, zero, 16
+    li t3, 0xA001
+crc16_loop:
+    xor t4, s1, a0
+    andi t4, t4, 1
+    srli s1, s1, 1
+    srli a0, a0, 1
+    beq t4, zero, crc16_next
+    xor s1, s1, t3
+crc16_next:
+    addi t5, t5, -1
+    bne t5, zero, crc16_loop
+    ret
+
+.include "common.s"
+
+str_coremark:
+    .asciz "coremark"
@@ -0,0 +1,57 @@
+; Copyright (c) 2026 Bastiaan van der Plaat
+; SPDX-License-Identifier: MIT
+
+; Memory bandwidth of the boot/string.s routines in RAM: memset and memcpy
+; of 4 KB, and a memcpy whose destination is one byte off so it takes the
+; byte loop.
+
+.include "../boot/consts.s"
+
+.equ COPY_SIZE,       4096
+.equ COPY_SRC,        0x20001000
+.equ COPY_DST,        0x20002000
+.equ COPY_DST_ODD,    0x20002001
+
+_start:
+    jal ra, bench_init
+
+    jal ra, bench_begin
+    li a0, COPY_SRC
+    addi a1, zero, 0x5A
+    li a2, COPY_SIZE
+    jal ra, memset
+    la a0, str_memset
+    li t0, COPY_SRC
+    lw a1, 0(t0)
+    jal ra, bench_end
+
+    jal ra, bench_begin
+    li a0, COPY_DST
+    li a1, COPY_SRC
+    li a2, COPY_SIZE
+    jal ra, memcpy
+    la a0, str_memcpy
+    li t0, COPY_DST
+    lw a1, 0(t0)
+    jal ra, bench_end
+
+    jal ra, bench_begin
+    li a0, COPY_DST_ODD
+    li a1, COPY_SRC
+    li a2, COPY_SIZE
+    jal ra, memcpy
+    la a0, str_memcpy_unaligned
+    li t0, COPY_DST
+    lw a1, 0(t0)
+    jal ra, bench_end
+
+    j bench_exit
+
+.include "common.s"
+
+str_memset:
+    .asciz "memset_4k"
+str_memcpy:
+    .asciz "memcpy_4k"
+str_memcpy_unaligned:
+    .asciz "memcpy_4k_unaligned"
@@ -0,0 +1,98 @@
+; Copyright (c) 2026 Bastiaan van der Plaat
+; SPDX-License-Identifier: MIT
+
+; Branch-heavy parser: tokenizes an expression into numbers, identifiers,
+; operators and parentheses, PASSES times, folding every token into a
+; checksum. Most characters take a different path than the one before.
+
+.include "../boot/consts.s"
+
+.equ PASSES,          16
+
+_start:
+    jal ra, bench_init
+
+    jal ra, bench_begin
+    addi s0, zero, PASSES
+    addi s1, zero, 0           ; checksum
+    addi s9, zero, 0           ; parenthesis depth
+parse_pass:
+    la a2, parse_text
+parse_next:
+    lbu t0, 0(a2)
+    beq t0, zero, parse_pass_done
+    addi a2, a2, 1
+    addi t1, zero, 32
+    beq t0, t1, parse_next
+    addi t1, zero, 48          ; '0'
+    blt t0, t1, parse_symbol
+    addi t1, zero, 58          ; '9' + 1
+    blt t0, t1, parse_number
+    addi t1, zero, 97          ; 'a'
+    blt t0, t1, parse_symbol
+    addi t1, zero, 123         ; 'z' + 1
+    blt t0, t1, parse_ident
+
+parse_symbol:
+    addi t1, zero, 40          ; '('
+    beq t0, t1, parse_open
+    addi t1, zero, 41          ; ')'
+    beq t0, t1, parse_close
+    slli t2, s1, 5             ; checksum = checksum * 31 + operator
+    sub s1, t2, s1
+    add s1, s1, t0
+    j parse_next
+parse_open:
+    addi s9, s9, 1
+    j parse_next
+parse_close:
+    add s1, s1, s9
+    addi s9, s9, -1
+    j parse_next
+
+parse_number:
+    addi t2, t0, -48
+    addi t1, zero, 10
+parse_number_loop:
+    lbu t0, 0(a2)
+    addi t0, t0, -48
+    bgeu t0, t1, parse_number_done
+    slli t3, t2, 3             ; value = value * 10 + digit
+    slli t4, t2, 1
+    add t2, t3, t4
+    add t2, t2, t0
+    addi a2, a2, 1
+    j parse_number_loop
+parse_number_done:
+    xor s1, s1, t2
+    j parse_next
+
+parse_ident:
+    addi t1, zero, 26
+parse_ident_loop:
+    slli t2, s1, 5             ; checksum = checksum * 33 + letter
+    add s1, s1, t2
+    add s1, s1, t0
+    lbu t0, 0(a2)
+    addi t3, t0, -97
+    bgeu t3, t1, parse_next
+    addi a2, a2, 1
+    j parse_ident_loop
+
+parse_pass_done:
+    addi s0, s0, -1
+    bne s0, zero, parse_pass
+
+    la a0, str_parser
+    mv a1, s1
+    jal ra, bench_end
+    j bench_exit
+
+.include "common.s"
+
+str_parser:
+    .asciz "parser"
+parse_text:
+    .ascii "(alpha + 12) * beta - 345 / (gamma + 6789) % delta + (x1 - 42) * (y2 + 7) "
+    .ascii "- ((count * 3) + (width / 2)) * height + 100000 - (offset % 256) "
+    .asciz "+ (left < right) - (top > bottom) * (((depth + 1) * 2) - 1) & mask | bits ^ 255"
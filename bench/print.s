@@ -0,0 +1,30 @@
+; Copyright (c) 2026 Bastiaan van der Plaat
+; SPDX-License-Identifier: MIT
+
+; String printing through the console: print_string queues each line for
+; the UART and draws it on the text display. The text fits in the TX ring,
+; so the time is the CPU work, not the baud rate.
+
+.include "../boot/consts.s"
+
+_start:
+    jal ra, bench_init
+
+    jal ra, bench_begin
+    la a0, str_text
+    jal ra, print_string
+    la a0, str_print
+    mv a1, s2
+    jal ra, bench_end
+
+    j bench_exit
+
+.include "common.s"
+
+str_print:
+    .asciz "print"
+str_text:
+    .ascii "The quick brown fox jumps over the lazy dog. 0123456789\r\n"
+    .ascii "Pack my box with five dozen liquor jugs! @$%^&*()[]{}\r\n"
+    .ascii "Sphinx of black quartz, judge my vow. +-*/=<>?|~_.,\r\n"
+    .asciz "How vexingly quick daft zebras jump. ABCDEFGHIJKLMNOP\r\n"
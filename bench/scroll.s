@@ -0,0 +1,41 @@
+; Copyright (c) 2026 Bastiaan van der Plaat
+; SPDX-License-Identifier: MIT
+
+; Full-screen scrolling: 120 lines of 79 glyphs go straight to the text
+; display, so the last 61 line feeds each clear a row with the blitter and
+; move the scroll origin.
+
+.include "../boot/consts.s"
+
+.equ SCROLL_LINES,    120
+.equ SCROLL_GLYPHS,   79
+
+_start:
+    jal ra, bench_init
+
+    jal ra, bench_begin
+    addi s0, zero, SCROLL_LINES
+scroll_line:
+    addi s1, zero, SCROLL_GLYPHS
+scroll_glyph:
+    addi a0, s1, 33
+    jal ra, video_putc
+    addi s1, s1, -1
+    bne s1, zero, scroll_glyph
+    addi a0, zero, 13
+    jal ra, video_putc
+    addi a0, zero, 10
+    jal ra, video_putc
+    addi s0, s0, -1
+    bne s0, zero, scroll_line
+    la a0, str_scroll
+    li t0, VIDEO_ORIGIN
+    lw a1, 0(t0)
+    jal ra, bench_end
+
+    j bench_exit
+
+.include "common.s"
+
+str_scroll:
+    .asciz "scroll"
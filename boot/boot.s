@@ -8,14 +8,38 @@ _start:
     lui sp, %hi(STACK_TOP)
     addi sp, sp, %lo(STACK_TOP)
 
-    ; Clear text video RAM and initialise the cursor.
-    li t0, VIDEO_BASE
-    li t1, VIDEO_END
-    li t2, VIDEO_BLANK
-video_clear_loop:
-    sw t2, 0(t0)
-    addi t0, t0, 4
-    blt t0, t1, video_clear_loop
+    ; Empty the UART rings and install the trap handler. The UART raises its
+    ; interrupt for received bytes; the TX FIFO empty interrupt is only
+    ; enabled while output is queued.
+    li t0, TX_HEAD
+    sw zero, 0(t0)
+    sw zero, 4(t0)
+    sw zero, 8(t0)
+    sw zero, 12(t0)
+    la t0, trap_handler
+    csrw mtvec, t0
+    li t0, UART_IRQ_ENABLE
+    addi t1, zero, 1
+    sw t1, 0(t0)
+    li t0, 0x800               ; MEIE
+    csrs mie, t0
+    csrsi mstatus, 8           ; MIE
+
+    ; Start clearing text video RAM with the blitter, reset the scroll origin
+    ; and initialise the cursor.
+    li t0, VIDEO_ORIGIN
+    sw zero, 0(t0)
+    li t0, VIDEO_BLIT_DST
+    sw zero, 0(t0)
+    li t0, VIDEO_BLIT_LEN
+    li t1, VIDEO_WORDS
+    sw t1, 0(t0)
+    li t0, VIDEO_BLIT_FILL
+    li t1, VIDEO_BLANK
+    sw t1, 0(t0)
+    li t0, VIDEO_BLIT_CTRL
+    addi t1, zero, BLIT_FILL
+    sw t1, 0(t0)
     li s2, VIDEO_BASE          ; cursor cell address
     addi s3, zero, 0           ; cursor column
     addi s4, zero, 0           ; cursor row
@@ -25,6 +49,13 @@ video_clear_loop:
     addi t1, zero, 1
     sw t1, 0(t0)
 
+    ; Wait for the clear to finish before printing.
+    li t0, VIDEO_BLIT_CTRL
+video_clear_wait:
+    lw t1, 0(t0)
+    andi t1, t1, 1
+    bne t1, zero, video_clear_wait
+
     ; Print banner
     la a0, str_banner
     jal ra, print_string
@@ -36,6 +67,9 @@ video_clear_loop:
 
 .include "repl.s"
 .include "console.s"
+.include "loader.s"
+.include "trap.s"
+.include "string.s"
 
 str_banner:
     .asciz "Zaheer REPL\r\n"
@@ -43,3 +77,32 @@ str_prompt:
     .asciz "> "
 str_crlf:
     .asciz "\r\n"
+
+    .align 2
+command_table:
+    .word str_command_char, command_char
+    .word str_command_load, command_load
+    .word str_command_perf, command_perf
+    .word 0
+str_command_char:
+    .asciz "char"
+    .align 2
+str_command_load:
+    .asciz "load"
+    .align 2
+str_command_perf:
+    .asciz "perf"
+
+; Counter names for command_perf, in the order it stores them
+str_perf_names:
+    .asciz "cycle     "
+    .asciz "instret   "
+    .asciz "load wait "
+    .asciz "stores    "
+    .asciz "branches  "
+    .asciz "uart      "
+    .asciz "taro      "
+    .asciz "ram       "
+    .asciz "rom       "
+    .asciz "psram     "
+    .byte 0
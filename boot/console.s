@@ -1,30 +1,72 @@
 ; Copyright (c) 2025-2026 Bastiaan van der Plaat
 ; SPDX-License-Identifier: MIT
 
-; Print null-terminated string pointed to by a0
+; Wait for a byte from the RX ring and return it in a0. Interrupts stay off
+; between the check and WFI so a wake-up cannot be missed.
+uart_getc:
+    li t0, RX_HEAD
+uart_getc_wait:
+    csrci mstatus, 8
+    lw t1, 0(t0)
+    lw t2, 4(t0)               ; RX_TAIL
+    bne t1, t2, uart_getc_ready
+    wfi
+    csrsi mstatus, 8
+    j uart_getc_wait
+uart_getc_ready:
+    csrsi mstatus, 8
+    andi t1, t2, RING_MASK
+    li t3, RX_RING
+    add t3, t3, t1
+    lbu a0, 0(t3)
+    addi t2, t2, 1
+    sw t2, 4(t0)
+    ret
+
+; Print null-terminated string pointed to by a0. The whole string is queued
+; for the UART in one go, then drawn on the text display.
 print_string:
     mv s5, a0
     mv s6, ra
+    jal ra, strlen
+    mv a1, a0
+    mv a0, s5
+    jal ra, uart_write
 print_str_loop:
     lbu a0, 0(s5)
     beq a0, zero, print_str_done
-    jal ra, print_char
+    jal ra, video_putc
     addi s5, s5, 1
     j print_str_loop
 print_str_done:
     mv ra, s6
     ret
 
+; Print a0 as eight hex digits
+print_hex:
+    li t0, HEX_BUF
+    addi t1, t0, 8
+    sb zero, 0(t1)
+print_hex_loop:
+    addi t1, t1, -1
+    andi t2, a0, 15
+    addi t2, t2, 48            ; '0'
+    addi t3, zero, 58
+    blt t2, t3, print_hex_digit
+    addi t2, t2, 39            ; 'a' - 10
+print_hex_digit:
+    sb t2, 0(t1)
+    srli a0, a0, 4
+    bne t1, t0, print_hex_loop
+    mv a0, t0
+    j print_string
+
 ; Print single char in a0
 print_char:
-    li t2, UART_TX_DATA
-    li t3, UART_TX_STATUS
-print_char_wait:
-    lw t1, 0(t3)
-    andi t1, t1, 1
-    bne t1, zero, print_char_wait
-    sb a0, 0(t2)
+    jal t6, uart_queue
 
+; Draw the char in a0 on the text display
+video_putc:
     ; Carriage return moves to column zero without changing rows.
     addi t0, zero, 13
     beq a0, t0, video_carriage_return
@@ -54,15 +96,78 @@ video_write_glyph:
 ; Print a glyph without interpreting control character values on the video
 ; display. The raw byte is still mirrored to UART.
 print_glyph:
-    li t2, UART_TX_DATA
-    li t3, UART_TX_STATUS
-print_glyph_wait:
-    lw t1, 0(t3)
-    andi t1, t1, 1
-    bne t1, zero, print_glyph_wait
-    sb a0, 0(t2)
+    jal t6, uart_queue
     j video_write_glyph
 
+; Append the byte in a0 to the TX ring and enable the TX FIFO empty interrupt
+; so the trap handler sends it. Sleeps while the ring is full. Interrupts stay
+; off between the check and WFI so a wake-up cannot be missed. Returns via t6.
+uart_queue:
+    li t0, TX_HEAD
+uart_queue_wait:
+    csrci mstatus, 8
+    lw t1, 0(t0)
+    lw t2, 4(t0)               ; TX_TAIL
+    sub t2, t1, t2
+    addi t3, zero, RING_SIZE
+    blt t2, t3, uart_queue_put
+    wfi
+    csrsi mstatus, 8
+    j uart_queue_wait
+uart_queue_put:
+    andi t2, t1, RING_MASK
+    li t3, TX_RING
+    add t3, t3, t2
+    sb a0, 0(t3)
+    addi t1, t1, 1
+    sw t1, 0(t0)
+    li t0, UART_IRQ_ENABLE
+    addi t1, zero, 3
+    sw t1, 0(t0)
+    csrsi mstatus, 8
+    jr t6
+
+; Append a1 bytes at a0 to the TX ring and enable the TX FIFO empty interrupt.
+; The ring and register addresses stay in registers, and the head index is
+; published once per batch. Sleeps while the ring is full, like uart_queue.
+; Clobbers a0-a2 and t0-t5.
+uart_write:
+    li t0, TX_HEAD
+    li t4, TX_RING
+    li t5, UART_IRQ_ENABLE
+uart_write_wait:
+    beq a1, zero, uart_write_done
+    csrci mstatus, 8
+    lw t1, 0(t0)
+    lw t2, 4(t0)               ; TX_TAIL
+    sub t2, t1, t2
+    addi t3, zero, RING_SIZE
+    blt t2, t3, uart_write_put
+    wfi
+    csrsi mstatus, 8
+    j uart_write_wait
+uart_write_put:
+    sub t2, t3, t2             ; free slots
+uart_write_byte:
+    andi t3, t1, RING_MASK
+    add t3, t3, t4
+    lbu a2, 0(a0)
+    sb a2, 0(t3)
+    addi a0, a0, 1
+    addi t1, t1, 1
+    addi a1, a1, -1
+    beq a1, zero, uart_write_publish
+    addi t2, t2, -1
+    bne t2, zero, uart_write_byte
+uart_write_publish:
+    sw t1, 0(t0)
+    addi t3, zero, 3
+    sw t3, 0(t5)
+    csrsi mstatus, 8
+    j uart_write_wait
+uart_write_done:
+    ret
+
 video_carriage_return:
     slli t0, s3, 1
     sub s2, s2, t0
@@ -80,31 +185,44 @@ video_backspace:
     addi s3, s3, -1
     ret
 
+; The cursor address wraps at the end of text RAM. Scrolling clears the
+; oldest row, which the cursor has just reached, and moves the display
+; origin down one row so it appears at the bottom.
 video_check_scroll:
+    li t0, VIDEO_END
+    blt s2, t0, video_check_rows
+    li t0, VIDEO_SIZE
+    sub s2, s2, t0
+video_check_rows:
     addi t0, zero, VIDEO_ROWS
     blt s4, t0, video_done
 
-    ; Copy rows 1-59 over rows 0-58 using two cells per word.
-    li t0, VIDEO_BASE
-    addi t1, t0, VIDEO_ROW_BYTES
-    li t2, VIDEO_END
-video_scroll_loop:
-    lw t3, 0(t1)
+    li t0, VIDEO_ORIGIN
+    lw t1, 0(t0)
+    addi t2, zero, VIDEO_ROW_WORDS
+    mul t3, t1, t2
+    li t0, VIDEO_BLIT_DST
     sw t3, 0(t0)
-    addi t0, t0, 4
-    addi t1, t1, 4
-    blt t1, t2, video_scroll_loop
-
-    ; Clear the final row and place the cursor at the retained column.
-    li t1, VIDEO_END
+    li t0, VIDEO_BLIT_LEN
+    sw t2, 0(t0)
+    li t0, VIDEO_BLIT_FILL
     li t2, VIDEO_BLANK
-video_clear_last_row:
     sw t2, 0(t0)
-    addi t0, t0, 4
-    blt t0, t1, video_clear_last_row
-    li s2, VIDEO_LAST_ROW
-    slli t0, s3, 1
-    add s2, s2, t0
+    li t0, VIDEO_BLIT_CTRL
+    addi t2, zero, BLIT_FILL
+    sw t2, 0(t0)
+video_clear_row_wait:
+    lw t2, 0(t0)
+    andi t2, t2, 1
+    bne t2, zero, video_clear_row_wait
+
+    addi t1, t1, 1
+    addi t2, zero, VIDEO_ROWS
+    blt t1, t2, video_set_origin
+    addi t1, zero, 0
+video_set_origin:
+    li t0, VIDEO_ORIGIN
+    sw t1, 0(t0)
     addi s4, zero, 59
 
 video_done:
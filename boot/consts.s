@@ -1,18 +1,55 @@
 ; Copyright (c) 2025-2026 Bastiaan van der Plaat
 ; SPDX-License-Identifier: MIT
 
-.equ STACK_TOP,       0x20001000
+.equ PSRAM_BASE,      0x10000000
+.equ STACK_TOP,       0x20004000
 .equ UART_TX_DATA,    0x40000000
 .equ UART_TX_STATUS,  0x40000004
 .equ UART_RX_STATUS,  0x40000008
 .equ UART_RX_DATA,    0x4000000C
+.equ UART_IRQ_ENABLE, 0x40000010
+.equ UART_DIVISOR,    0x40000014
+.equ UART_LEVELS,     0x40000018
+.equ UART_THRESHOLDS, 0x4000001C
 .equ LED_REG,         0x60000000
+.equ TIMER_MTIME,     0xA0000000
+.equ TIMER_MTIMEH,    0xA0000004
+.equ TIMER_MTIMECMP,  0xA0000008
+.equ TIMER_MTIMECMPH, 0xA000000C
 .equ VIDEO_BASE,      0x80000000
 .equ VIDEO_END,       0x80002580
-.equ VIDEO_LAST_ROW,  0x800024e0
+.equ VIDEO_SIZE,      0x2580
+.equ VIDEO_ORIGIN,    0x80003000
+.equ VIDEO_BLIT_SRC,  0x80003004
+.equ VIDEO_BLIT_DST,  0x80003008
+.equ VIDEO_BLIT_LEN,  0x8000300C
+.equ VIDEO_BLIT_FILL, 0x80003010
+.equ VIDEO_BLIT_CTRL, 0x80003014
+.equ BLIT_FILL,       1
+.equ BLIT_COPY,       2
 .equ VIDEO_COLS,      80
 .equ VIDEO_ROWS,      60
 .equ VIDEO_ROW_BYTES, 160
+.equ VIDEO_ROW_WORDS, 40
+.equ VIDEO_WORDS,     2400
 .equ VIDEO_BLANK,     0x07200720
-.equ BUF_ADDR,        0x20000000
+
+; RAM scratch map, below the loader image at LOAD_ADDR
+.equ BUF_ADDR,        0x20000000   ; line buffer, BUF_MAX bytes and a NUL
 .equ BUF_MAX,         255
+.equ TX_RING,         0x20000100
+.equ RX_RING,         0x20000200
+.equ RING_SIZE,       256
+.equ RING_MASK,       255
+.equ TX_HEAD,         0x20000300
+.equ TX_TAIL,         0x20000304
+.equ RX_HEAD,         0x20000308
+.equ RX_TAIL,         0x2000030C
+.equ BENCH_START,     0x20000310   ; cycle and instret at bench_begin
+.equ BENCH_DEC_END,   0x20000324   ; NUL after the print_dec digits, up to 10 before it
+.equ HEX_BUF,         0x20000328   ; print_hex digits and a NUL
+.equ LOAD_ADDR,       0x20001000
+.equ LOAD_MAX,        0x2800
+.equ LOAD_CHUNK,      256
+.equ ACK,             0x06
+.equ NAK,             0x15
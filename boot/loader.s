@@ -0,0 +1,143 @@
+; Copyright (c) 2026 Bastiaan van der Plaat
+; SPDX-License-Identifier: MIT
+
+; Receive an image over UART into RAM at LOAD_ADDR and run it. This is the
+; device side of tools/load.c; words are little-endian:
+;   device: ACK when ready
+;   host:   image length, CRC-32 of the image, UART divisor for the transfer
+;   device: ACK, or NAK when the length is zero or above LOAD_MAX or the
+;           divisor is outside 2-0xFFFF; once the ACK has left the UART the
+;           device switches to the new divisor
+;   host:   the image in LOAD_CHUNK byte chunks at the new rate, the last
+;           one may be shorter
+;   device: ACK after every chunk
+;   device: ACK and jump to the image when the CRC-32 matches, else NAK
+; Only ACK and NAK are sent so the host never has to skip output. After its
+; last reply the device goes back to the old divisor, so the image and the
+; REPL after a NAK talk at the console rate. The image starts with interrupts
+; disabled; a NAK returns to the REPL.
+command_load:
+    mv s7, ra
+    li t0, UART_DIVISOR
+    lw s5, 0(t0)               ; s5 = console divisor, restored at the end
+    addi a0, zero, ACK
+    jal t6, uart_queue
+
+    ; Header: collect it in the line buffer, s8 = length, s9 = CRC-32,
+    ; s6 = transfer divisor
+    li s10, BUF_ADDR
+    addi s11, s10, 12
+load_header_loop:
+    jal ra, uart_getc
+    sb a0, 0(s10)
+    addi s10, s10, 1
+    bltu s10, s11, load_header_loop
+    li t0, BUF_ADDR
+    lw s8, 0(t0)
+    lw s9, 4(t0)
+    lw s6, 8(t0)
+    beq s8, zero, load_nak
+    li t0, LOAD_MAX
+    bltu t0, s8, load_nak
+    addi t0, s6, -2
+    li t1, 0xFFFD
+    bltu t1, t0, load_nak
+    addi a0, zero, ACK
+    jal t6, uart_queue
+    jal t6, load_flush
+    li t0, UART_DIVISOR
+    sw s6, 0(t0)
+
+    ; Image: s10 = write pointer, s11 = end, a1 = running CRC-32,
+    ; a2 = bytes left in the chunk, a3 = load_crc_table
+    li s10, LOAD_ADDR
+    add s11, s10, s8
+    li a1, 0xFFFFFFFF
+    la a3, load_crc_table
+load_chunk:
+    addi a2, zero, LOAD_CHUNK
+load_byte:
+    jal ra, uart_getc
+    sb a0, 0(s10)
+    addi s10, s10, 1
+    ; CRC-32 a nibble at a time: shift out the low four bits and fold in
+    ; their table entry
+    xor a1, a1, a0
+    andi t0, a1, 15
+    slli t0, t0, 2
+    add t0, t0, a3
+    lw t0, 0(t0)
+    srli a1, a1, 4
+    xor a1, a1, t0
+    andi t0, a1, 15
+    slli t0, t0, 2
+    add t0, t0, a3
+    lw t0, 0(t0)
+    srli a1, a1, 4
+    xor a1, a1, t0
+    addi a2, a2, -1
+    beq s10, s11, load_check
+    bne a2, zero, load_byte
+    addi a0, zero, ACK
+    jal t6, uart_queue
+    j load_chunk
+
+load_check:
+    addi a0, zero, ACK
+    jal t6, uart_queue
+    not a1, a1
+    bne a1, s9, load_nak
+    addi a0, zero, ACK
+    jal t6, uart_queue
+
+    ; Send the final ACK at the transfer rate, go back to the console rate
+    ; and jump with interrupts off
+    jal t6, load_flush
+    li t0, UART_DIVISOR
+    sw s5, 0(t0)
+    csrci mstatus, 8
+    csrw mie, zero
+    li t0, UART_IRQ_ENABLE
+    sw zero, 0(t0)
+    fence.i
+    li t0, LOAD_ADDR
+    jr t0
+
+load_nak:
+    addi a0, zero, NAK
+    jal t6, uart_queue
+    jal t6, load_flush
+    li t0, UART_DIVISOR
+    sw s5, 0(t0)
+    mv ra, s7
+    ret
+
+; Wait until the trap handler has handed the TX ring to the UART and the
+; UART has sent the last stop bit, so the divisor can change without cutting
+; a byte short. Returns via t6 with interrupts on.
+load_flush:
+    li t0, TX_HEAD
+load_flush_ring:
+    csrci mstatus, 8
+    lw t1, 0(t0)
+    lw t2, 4(t0)               ; TX_TAIL
+    beq t1, t2, load_flush_line
+    wfi
+    csrsi mstatus, 8
+    j load_flush_ring
+load_flush_line:
+    csrsi mstatus, 8
+    li t0, UART_TX_STATUS
+load_flush_wait:
+    lw t1, 0(t0)
+    andi t1, t1, 2             ; busy
+    bne t1, zero, load_flush_wait
+    jr t6
+
+; CRC-32 of each nibble value, for the reflected polynomial 0xEDB88320
+    .align 2
+load_crc_table:
+    .word 0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC
+    .word 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C
+    .word 0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C
+    .word 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
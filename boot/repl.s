@@ -11,16 +11,7 @@ repl:
     li s1, BUF_ADDR
 
 read_loop:
-    ; Poll UART RX status
-    li t0, UART_RX_STATUS
-wait_rx:
-    lw t1, 0(t0)
-    andi t1, t1, 1
-    beq t1, zero, wait_rx
-
-    ; Read received byte
-    li t0, UART_RX_DATA
-    lbu a0, 0(t0)
+    jal ra, uart_getc
 
     ; Handle Enter (\r = 13)
     addi t1, zero, 13
@@ -65,22 +56,20 @@ enter_pressed:
     la a0, str_crlf
     jal ra, print_string
 
-    ; Dispatch the "char" command.
-    lbu t0, 0(s1)
-    addi t1, zero, 99         ; 'c'
-    bne t0, t1, echo_command
-    lbu t0, 1(s1)
-    addi t1, zero, 104        ; 'h'
-    bne t0, t1, echo_command
-    lbu t0, 2(s1)
-    addi t1, zero, 97         ; 'a'
-    bne t0, t1, echo_command
-    lbu t0, 3(s1)
-    addi t1, zero, 114        ; 'r'
-    bne t0, t1, echo_command
-    lbu t0, 4(s1)
-    bne t0, zero, echo_command
-    jal ra, command_char
+    ; Look the line up in the command table: pairs of name and handler,
+    ; ended by a zero name.
+    la s7, command_table
+dispatch_loop:
+    lw a1, 0(s7)
+    beq a1, zero, echo_command
+    mv a0, s1
+    jal ra, strcmp
+    beq a0, zero, dispatch_found
+    addi s7, s7, 8
+    j dispatch_loop
+dispatch_found:
+    lw t0, 4(s7)
+    jalr ra, 0(t0)
     j repl
 
 echo_command:
@@ -108,3 +97,49 @@ command_char_next:
     blt s8, t0, command_char_loop
     mv ra, s7
     ret
+
+; Print the performance counters, low 32 bits in hex. They are copied to the
+; line buffer first so printing does not disturb them.
+command_perf:
+    mv s7, ra
+    li t0, BUF_ADDR
+    rdcycle t1
+    sw t1, 0(t0)
+    rdinstret t1
+    sw t1, 4(t0)
+    csrr t1, hpmcounter3
+    sw t1, 8(t0)
+    csrr t1, hpmcounter4
+    sw t1, 12(t0)
+    csrr t1, hpmcounter5
+    sw t1, 16(t0)
+    csrr t1, hpmcounter6
+    sw t1, 20(t0)
+    csrr t1, hpmcounter7
+    sw t1, 24(t0)
+    csrr t1, hpmcounter8
+    sw t1, 28(t0)
+    csrr t1, hpmcounter9
+    sw t1, 32(t0)
+    csrr t1, hpmcounter10
+    sw t1, 36(t0)
+
+    ; s8 = next counter, s9 = its name in str_perf_names
+    li s8, BUF_ADDR
+    la s9, str_perf_names
+command_perf_loop:
+    mv a0, s9
+    jal ra, print_string
+    mv a0, s9
+    jal ra, strlen
+    add s9, s9, a0
+    addi s9, s9, 1
+    lw a0, 0(s8)
+    jal ra, print_hex
+    la a0, str_crlf
+    jal ra, print_string
+    addi s8, s8, 4
+    lbu t0, 0(s9)
+    bne t0, zero, command_perf_loop
+    mv ra, s7
+    ret
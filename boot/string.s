@@ -0,0 +1,183 @@
+; Copyright (c) 2026 Bastiaan van der Plaat
+; SPDX-License-Identifier: MIT
+
+; Memory and string routines. Arguments and results use a0-a2; the routines
+; are leaves that return via ra and clobber a1, a2 and t0-t5. Word loops only
+; run when both pointers share the same word alignment; unaligned heads and
+; the remaining tail bytes are handled one byte at a time.
+
+; Copy a2 bytes from a1 to a0. The regions must not overlap.
+memcpy:
+    mv t0, a0
+    xor t1, a0, a1
+    andi t1, t1, 3
+    bne t1, zero, memcpy_bytes
+memcpy_head:
+    andi t1, t0, 3
+    beq t1, zero, memcpy_blocks
+    beq a2, zero, memcpy_done
+    lbu t1, 0(a1)
+    sb t1, 0(t0)
+    addi t0, t0, 1
+    addi a1, a1, 1
+    addi a2, a2, -1
+    j memcpy_head
+memcpy_blocks:
+    addi t1, zero, 16
+memcpy_block_loop:
+    bltu a2, t1, memcpy_words
+    lw t2, 0(a1)
+    lw t3, 4(a1)
+    lw t4, 8(a1)
+    lw t5, 12(a1)
+    sw t2, 0(t0)
+    sw t3, 4(t0)
+    sw t4, 8(t0)
+    sw t5, 12(t0)
+    addi t0, t0, 16
+    addi a1, a1, 16
+    addi a2, a2, -16
+    j memcpy_block_loop
+memcpy_words:
+    addi t1, zero, 4
+memcpy_word_loop:
+    bltu a2, t1, memcpy_bytes
+    lw t2, 0(a1)
+    sw t2, 0(t0)
+    addi t0, t0, 4
+    addi a1, a1, 4
+    addi a2, a2, -4
+    j memcpy_word_loop
+memcpy_bytes:
+    beq a2, zero, memcpy_done
+    lbu t1, 0(a1)
+    sb t1, 0(t0)
+    addi t0, t0, 1
+    addi a1, a1, 1
+    addi a2, a2, -1
+    j memcpy_bytes
+memcpy_done:
+    ret
+
+; Set a2 bytes at a0 to the low byte of a1.
+memset:
+    mv t0, a0
+    andi a1, a1, 255
+    slli t1, a1, 8
+    or a1, a1, t1
+    slli t1, a1, 16
+    or a1, a1, t1
+memset_head:
+    andi t1, t0, 3
+    beq t1, zero, memset_blocks
+    beq a2, zero, memset_done
+    sb a1, 0(t0)
+    addi t0, t0, 1
+    addi a2, a2, -1
+    j memset_head
+memset_blocks:
+    addi t1, zero, 16
+memset_block_loop:
+    bltu a2, t1, memset_words
+    sw a1, 0(t0)
+    sw a1, 4(t0)
+    sw a1, 8(t0)
+    sw a1, 12(t0)
+    addi t0, t0, 16
+    addi a2, a2, -16
+    j memset_block_loop
+memset_words:
+    addi t1, zero, 4
+memset_word_loop:
+    bltu a2, t1, memset_bytes
+    sw a1, 0(t0)
+    addi t0, t0, 4
+    addi a2, a2, -4
+    j memset_word_loop
+memset_bytes:
+    beq a2, zero, memset_done
+    sb a1, 0(t0)
+    addi t0, t0, 1
+    addi a2, a2, -1
+    j memset_bytes
+memset_done:
+    ret
+
+; Return the length of the null-terminated string at a0 in a0. A word holds a
+; zero byte exactly when (word - 0x01010101) & ~word & 0x80808080 is non-zero.
+strlen:
+    mv t0, a0
+strlen_head:
+    andi t1, t0, 3
+    beq t1, zero, strlen_words
+    lbu t1, 0(t0)
+    beq t1, zero, strlen_done
+    addi t0, t0, 1
+    j strlen_head
+strlen_words:
+    li t2, 0x01010101
+    slli t3, t2, 7             ; 0x80808080
+strlen_word_loop:
+    lw t1, 0(t0)
+    sub t4, t1, t2
+    not t5, t1
+    and t4, t4, t5
+    and t4, t4, t3
+    bne t4, zero, strlen_tail
+    addi t0, t0, 4
+    j strlen_word_loop
+strlen_tail:
+    ; The word at t0 holds the terminator
+    lbu t1, 0(t0)
+    beq t1, zero, strlen_done
+    addi t0, t0, 1
+    j strlen_tail
+strlen_done:
+    sub a0, t0, a0
+    ret
+
+; Compare the null-terminated strings at a0 and a1. Returns zero in a0 when
+; they are equal, else the difference of the first differing bytes.
+strcmp:
+    xor t0, a0, a1
+    andi t0, t0, 3
+    bne t0, zero, strcmp_bytes
+strcmp_head:
+    andi t0, a0, 3
+    beq t0, zero, strcmp_words
+    lbu t0, 0(a0)
+    lbu t1, 0(a1)
+    bne t0, t1, strcmp_diff
+    beq t0, zero, strcmp_diff
+    addi a0, a0, 1
+    addi a1, a1, 1
+    j strcmp_head
+strcmp_words:
+    li t2, 0x01010101
+    slli t3, t2, 7             ; 0x80808080
+strcmp_word_loop:
+    lw t0, 0(a0)
+    lw t1, 0(a1)
+    bne t0, t1, strcmp_bytes   ; find the differing byte
+    sub t4, t0, t2
+    not t5, t0
+    and t4, t4, t5
+    and t4, t4, t3
+    bne t4, zero, strcmp_equal
+    addi a0, a0, 4
+    addi a1, a1, 4
+    j strcmp_word_loop
+strcmp_equal:
+    mv a0, zero
+    ret
+strcmp_bytes:
+    lbu t0, 0(a0)
+    lbu t1, 0(a1)
+    bne t0, t1, strcmp_diff
+    beq t0, zero, strcmp_diff
+    addi a0, a0, 1
+    addi a1, a1, 1
+    j strcmp_bytes
+strcmp_diff:
+    sub a0, t0, t1
+    ret
@@ -0,0 +1,149 @@
+; Copyright (c) 2026 Bastiaan van der Plaat
+; SPDX-License-Identifier: MIT
+
+; Machine trap handler. Only the UART interrupt is enabled, so every interrupt
+; drains the UART RX FIFO into the RX ring and refills the TX FIFO from the TX
+; ring. The ring indices count up freely and are masked when used as an offset.
+; Exceptions (ecall, ebreak, illegal instructions) are fatal: the handler
+; reports mcause and mepc over the UART and halts.
+str_trap_cause:
+    .asciz "\r\nTrap mcause "
+str_trap_pc:
+    .asciz " mepc "
+str_trap_end:
+    .asciz "\r\n"
+
+.align 2
+trap_handler:
+    addi sp, sp, -32
+    sw t0, 0(sp)
+    sw t1, 4(sp)
+    sw t2, 8(sp)
+    sw t3, 12(sp)
+    sw t4, 16(sp)
+    csrr t0, mcause
+    bge t0, zero, trap_exception   ; mcause bit 31 is clear for exceptions
+
+trap_rx:
+    ; Receive: append each byte to the RX ring, dropping it when the ring is full
+    li t0, UART_RX_STATUS
+    lw t1, 0(t0)
+    andi t1, t1, 1
+    beq t1, zero, trap_tx
+    li t0, UART_RX_DATA
+    lbu t1, 0(t0)
+    li t0, RX_HEAD
+    lw t2, 0(t0)
+    lw t3, 4(t0)               ; RX_TAIL
+    sub t3, t2, t3
+    addi t4, zero, RING_SIZE
+    bge t3, t4, trap_rx
+    andi t3, t2, RING_MASK
+    li t4, RX_RING
+    add t4, t4, t3
+    sb t1, 0(t4)
+    addi t2, t2, 1
+    sw t2, 0(t0)
+    j trap_rx
+
+trap_tx:
+    ; Transmit: move queued bytes until the ring is empty or the FIFO is full
+    li t0, TX_HEAD
+    lw t2, 0(t0)
+    lw t3, 4(t0)               ; TX_TAIL
+    beq t2, t3, trap_tx_idle
+    li t1, UART_TX_STATUS
+    lw t1, 0(t1)
+    andi t1, t1, 1
+    bne t1, zero, trap_done
+    andi t1, t3, RING_MASK
+    li t4, TX_RING
+    add t4, t4, t1
+    lbu t1, 0(t4)
+    li t4, UART_TX_DATA
+    sb t1, 0(t4)
+    addi t3, t3, 1
+    sw t3, 4(t0)
+    j trap_tx
+
+trap_tx_idle:
+    ; The TX ring is empty, so only keep the RX interrupt enabled
+    li t0, UART_IRQ_ENABLE
+    addi t1, zero, 1
+    sw t1, 0(t0)
+
+trap_done:
+    lw t0, 0(sp)
+    lw t1, 4(sp)
+    lw t2, 8(sp)
+    lw t3, 12(sp)
+    lw t4, 16(sp)
+    addi sp, sp, 32
+    mret
+
+trap_exception:
+    ; Interrupts stay off from here on, so first send what is left in the TX
+    ; ring by polling the UART, then the report
+    li t0, TX_RING
+    li t1, TX_HEAD
+    lw t2, 0(t1)
+    lw t3, 4(t1)               ; TX_TAIL
+trap_exception_flush:
+    beq t3, t2, trap_exception_report
+    andi t1, t3, RING_MASK
+    add t1, t1, t0
+    lbu a0, 0(t1)
+    jal t6, trap_putc
+    addi t3, t3, 1
+    j trap_exception_flush
+trap_exception_report:
+    la a1, str_trap_cause
+    jal ra, trap_puts
+    csrr a2, mcause
+    jal ra, trap_puthex
+    la a1, str_trap_pc
+    jal ra, trap_puts
+    csrr a2, mepc
+    jal ra, trap_puthex
+    la a1, str_trap_end
+    jal ra, trap_puts
+trap_halt:
+    wfi
+    j trap_halt
+
+; Print the string at a1 by polling the UART. Clobbers a0, a1, t4 and t5.
+trap_puts:
+    lbu a0, 0(a1)
+    beq a0, zero, trap_puts_done
+    jal t6, trap_putc
+    addi a1, a1, 1
+    j trap_puts
+trap_puts_done:
+    ret
+
+; Print a2 as eight hex digits by polling the UART. Clobbers a0, a2, t2-t5.
+trap_puthex:
+    addi t3, zero, 8
+    addi t2, zero, 58
+trap_puthex_loop:
+    srli a0, a2, 28
+    addi a0, a0, 48            ; '0'
+    blt a0, t2, trap_puthex_digit
+    addi a0, a0, 39            ; 'a' - 10
+trap_puthex_digit:
+    jal t6, trap_putc
+    slli a2, a2, 4
+    addi t3, t3, -1
+    bne t3, zero, trap_puthex_loop
+    ret
+
+; Write the byte in a0 to the UART TX FIFO once it has room. Returns via t6.
+trap_putc:
+    li t5, UART_TX_STATUS
+trap_putc_wait:
+    lw t4, 0(t5)
+    andi t4, t4, 1
+    bne t4, zero, trap_putc_wait
+    li t5, UART_TX_DATA
+    sb a0, 0(t5)
+    jr t6
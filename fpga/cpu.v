@@ -4,31 +4,53 @@
  * SPDX-License-Identifier: MIT
  */
 
-// RV32I multi-cycle CPU
-// No CSR/trap support; ECALL/EBREAK/FENCE treated as NOPs.
+// RV32IMC multi-cycle CPU
+// Multiplies complete in EXECUTE; divides wait 32 cycles in STATE_DIVIDE.
+// Compressed instructions are expanded by cpu_rvc while the fetched word is
+// captured. A 32-bit instruction at pc[1] = 1 straddles two words and takes
+// one extra bus cycle in STATE_FETCH_HIGH.
+// Machine-mode traps (cpu_csr): ECALL, EBREAK and illegal instructions trap
+// in EXECUTE, interrupts are taken in FETCH between two instructions and WFI
+// holds EXECUTE until an enabled interrupt is pending. FENCE is a NOP.
 // Misaligned accesses are not trapped.
+// Performance counters: mhpmcounter3 load wait cycles (MEMORY and MEM_READ),
+// 4 stores, 5 taken branches, 6-10 bus cycles (instruction fetches and data
+// accesses) per bus_region: UART, Taro, RAM, ROM, PSRAM.
 module cpu(
     input wire clk,
     input wire rst,
 
     // Memory bus: drive addr/data/control in one cycle,
-    // response (mem_rdata) available next cycle
+    // response (mem_rdata) available next cycle. A device that needs longer
+    // holds mem_ready low and the request stays driven until it is high.
     output reg [31:0] mem_addr,
     output reg [31:0] mem_wdata,
     input wire [31:0] mem_rdata,
+    input wire mem_ready,
     output reg mem_we,
     output reg mem_re,
-    output reg [3:0] mem_wstrb
+    output reg [3:0] mem_wstrb,
+
+    // Level-sensitive interrupt lines (mip.MTIP and mip.MEIP)
+    input wire timer_irq,
+    input wire external_irq,
+
+    // SoC address decode of mem_addr for the performance counters, one-hot:
+    // bit 0 UART, 1 Taro, 2 RAM, 3 ROM, 4 PSRAM
+    input wire [4:0] bus_region
 );
 
-    // CPU states (7 states, most instructions 5 cycles, stores 6, loads 7)
-    localparam STATE_FETCH     = 3'd0, // Drive bus with PC
-               STATE_DECODE    = 3'd1, // Capture instruction from bus
-               STATE_REGREAD   = 3'd2, // Read register file
-               STATE_EXECUTE   = 3'd3, // ALU / branch / address calc
-               STATE_MEMORY    = 3'd4, // Complete store or wait for load data
-               STATE_WRITEBACK = 3'd5, // Write register file, update PC
-               STATE_MEM_READ  = 3'd6; // Capture synchronous memory read
+    // CPU states (9 states, most instructions 5 cycles, stores 6, loads 7,
+    // divides 38, plus one cycle for a word-straddling 32-bit instruction)
+    localparam STATE_FETCH      = 4'd0, // Drive bus with PC
+               STATE_DECODE     = 4'd1, // Capture instruction from bus
+               STATE_REGREAD    = 4'd2, // Read register file
+               STATE_EXECUTE    = 4'd3, // ALU / branch / address calc
+               STATE_MEMORY     = 4'd4, // Complete store or wait for load data
+               STATE_WRITEBACK  = 4'd5, // Write register file, update PC
+               STATE_MEM_READ   = 4'd6, // Capture synchronous memory read
+               STATE_DIVIDE     = 4'd7, // Wait for the divider
+               STATE_FETCH_HIGH = 4'd8; // Capture upper half of a straddling instruction
 
     // Opcodes
     localparam OP_LUI    = 7'b0110111,
@@ -58,10 +80,12 @@ module cpu(
     // Registers
     reg [31:0] pc;
     (* syn_ramstyle = "block_ram" *) reg [31:0] regs [0:31];
-    (* fsm_encoding = "one-hot" *) reg [2:0] state;
+    (* fsm_encoding = "one-hot" *) reg [3:0] state;
 
-    // Instruction register and decoded fields
+    // Instruction register (always the 32-bit form) and decoded fields
     reg [31:0] instr;
+    reg compressed; // instr was expanded from a 16-bit instruction
+    reg rvc_illegal; // instr came from a reserved 16-bit encoding
     wire [6:0] opcode = instr[6:0];
     wire [4:0] rd     = instr[11:7];
     wire [2:0] funct3 = instr[14:12];
@@ -76,6 +100,21 @@ module cpu(
     wire [31:0] imm_u = {instr[31:12], 12'b0};
     wire [31:0] imm_j = {{11{instr[31]}}, instr[31], instr[19:12], instr[20], instr[30:21], 1'b0};
 
+    // Fetch: pick the halfword at pc out of the word on the bus and expand it
+    // if it is a compressed instruction (low bits != 2'b11)
+    wire [15:0] fetch_half = pc[1] ? mem_rdata[31:16] : mem_rdata[15:0];
+    wire fetch_compressed = fetch_half[1:0] != 2'b11;
+    wire [31:0] fetch_expanded;
+    wire fetch_illegal;
+    cpu_rvc rvc(
+        .cinstr(fetch_half),
+        .instr(fetch_expanded),
+        .illegal(fetch_illegal)
+    );
+
+    // Address of the sequential next instruction, also the link address
+    wire [31:0] pc_seq = pc + (compressed ? 32'd2 : 32'd4);
+
     // Registered operands from REGREAD stage.
     // Synchronous BRAM read: address (rs1/rs2 from instr) is valid during REGREAD,
     // so the output is available in EXECUTE one cycle later.
@@ -154,6 +193,29 @@ module cpu(
         endcase
     end
 
+    // M extension: funct7 0000001 on OP_REG
+    wire is_muldiv = (opcode == OP_REG) && (funct7 == 7'b0000001);
+
+    // 33x33 signed multiply covers MUL, MULH, MULHSU and MULHU (maps to DSP)
+    wire signed [32:0] mul_a = {(funct3 == 3'b001 || funct3 == 3'b010) && rs1_val[31], rs1_val};
+    wire signed [32:0] mul_b = {funct3 == 3'b001 && rs2_val[31], rs2_val};
+    wire signed [65:0] mul_product = mul_a * mul_b;
+    wire [31:0] mul_result = (funct3 == 3'b000) ? mul_product[31:0] : mul_product[63:32];
+
+    wire div_done;
+    wire [31:0] div_result;
+    cpu_divider divider(
+        .clk(clk),
+        .rst(rst),
+        .start(state == STATE_EXECUTE && is_muldiv && funct3[2]),
+        .op(funct3[1:0]),
+        .dividend(rs1_val),
+        .divisor(rs2_val),
+        .busy(),
+        .done(div_done),
+        .result(div_result)
+    );
+
     // Branch comparison (combinational from rs1_val/rs2_val)
     reg branch_taken;
     always @(*) begin
@@ -168,6 +230,64 @@ module cpu(
         endcase
     end
 
+    // System instructions and exceptions
+    wire is_csr    = opcode == OP_SYSTEM && funct3[1:0] != 2'b00;
+    wire is_ecall  = instr == 32'h00000073;
+    wire is_ebreak = instr == 32'h00100073;
+    wire is_mret   = instr == 32'h30200073;
+    wire is_wfi    = instr == 32'h10500073;
+    reg is_illegal;
+    always @(*) begin
+        case (opcode)
+            OP_LUI, OP_AUIPC, OP_JAL, OP_JALR, OP_BRANCH, OP_LOAD, OP_STORE,
+            OP_IMM, OP_REG, OP_FENCE:
+                is_illegal = rvc_illegal;
+            OP_SYSTEM:
+                is_illegal = !(is_csr || is_ecall || is_ebreak || is_mret || is_wfi);
+            default:
+                is_illegal = 1;
+        endcase
+    end
+    wire exception = state == STATE_EXECUTE && (is_illegal || is_ecall || is_ebreak);
+    wire [31:0] exception_cause = is_illegal ? 32'd2 : is_ecall ? 32'd11 : 32'd3;
+
+    // Performance events: cycles waiting on the bus for an instruction word
+    // or a data access, and whether the instruction in WRITEBACK retires
+    wire bus_wait = state == STATE_DECODE || state == STATE_FETCH_HIGH ||
+                    state == STATE_MEMORY || state == STATE_MEM_READ;
+    reg retire;
+
+    // CSRRS/CSRRC with rs1 = x0 (or a zero immediate) only read
+    wire csr_irq_pending, csr_wfi_wake;
+    wire [31:0] csr_rdata, csr_mtvec, csr_mepc, csr_irq_cause;
+    cpu_csr csr(
+        .clk(clk),
+        .rst(rst),
+        .addr(instr[31:20]),
+        .we(state == STATE_EXECUTE && is_csr && !(funct3[1] && rs1 == 5'd0)),
+        .op(funct3[1:0]),
+        .src(funct3[2] ? {27'b0, rs1} : rs1_val),
+        .rdata(csr_rdata),
+        .trap(exception || (state == STATE_FETCH && csr_irq_pending)),
+        .trap_pc(pc),
+        .trap_cause(exception ? exception_cause : csr_irq_cause),
+        .mret(state == STATE_EXECUTE && is_mret),
+        .mtvec(csr_mtvec),
+        .mepc(csr_mepc),
+        .timer_irq(timer_irq),
+        .external_irq(external_irq),
+        .irq_pending(csr_irq_pending),
+        .irq_cause(csr_irq_cause),
+        .wfi_wake(csr_wfi_wake),
+        .instret(state == STATE_WRITEBACK && retire),
+        .hpm_event({
+            {5{bus_wait}} & bus_region,
+            state == STATE_EXECUTE && !exception && opcode == OP_BRANCH && branch_taken,
+            state == STATE_MEMORY && opcode == OP_STORE,
+            (state == STATE_MEMORY || state == STATE_MEM_READ) && opcode == OP_LOAD
+        })
+    );
+
     // Execution state
     reg [31:0] exec_result;
     reg [31:0] next_pc;
@@ -222,25 +342,53 @@ module cpu(
             mem_addr <= 32'b0;
             mem_wdata <= 32'b0;
             instr <= 32'b0;
+            compressed <= 0;
+            rvc_illegal <= 0;
             write_rd <= 0;
+            retire <= 0;
             next_pc <= 32'b0;
             exec_result <= 32'b0;
             eff_addr <= 32'b0;
             // regs initialised by BRAM to zero; no explicit reset loop needed
         end else begin
             case (state)
-                // Drive address bus with PC, request instruction read
+                // Drive address bus with the word holding PC, request
+                // instruction read
                 STATE_FETCH: begin
-                    mem_addr <= pc;
-                    mem_re <= 1;
                     mem_we <= 0;
                     mem_wstrb <= 4'b0000;
-                    state <= STATE_DECODE;
+                    if (csr_irq_pending) begin
+                        // Take the interrupt instead; mepc = pc
+                        pc <= csr_mtvec;
+                    end else begin
+                        mem_addr <= {pc[31:2], 2'b00};
+                        mem_re <= 1;
+                        state <= STATE_DECODE;
+                    end
                 end
 
                 // Capture instruction (bus responds 1 cycle after request)
-                STATE_DECODE: begin
-                    instr <= mem_rdata;
+                STATE_DECODE: if (mem_ready) begin
+                    compressed <= fetch_compressed;
+                    rvc_illegal <= fetch_compressed && fetch_illegal;
+                    if (fetch_compressed) begin
+                        instr <= fetch_expanded;
+                        mem_re <= 0;
+                        state <= STATE_REGREAD;
+                    end else if (pc[1]) begin
+                        // Lower half is in this word, read the next one
+                        instr[15:0] <= fetch_half;
+                        mem_addr <= {pc[31:2] + 30'd1, 2'b00};
+                        state <= STATE_FETCH_HIGH;
+                    end else begin
+                        instr <= mem_rdata;
+                        mem_re <= 0;
+                        state <= STATE_REGREAD;
+                    end
+                end
+
+                STATE_FETCH_HIGH: if (mem_ready) begin
+                    instr[31:16] <= mem_rdata[15:0];
                     mem_re <= 0;
                     state <= STATE_REGREAD;
                 end
@@ -255,9 +403,13 @@ module cpu(
                 // available combinationally via alu_result
                 STATE_EXECUTE: begin
                     write_rd <= 0;
-                    next_pc <= pc + 4;
+                    next_pc <= pc_seq;
+                    retire <= !exception;
 
-                    case (opcode)
+                    if (exception) begin
+                        next_pc <= csr_mtvec;
+                        state <= STATE_WRITEBACK;
+                    end else case (opcode)
                         OP_LUI: begin
                             exec_result <= imm_u;
                             write_rd <= 1;
@@ -271,14 +423,14 @@ module cpu(
                         end
 
                         OP_JAL: begin
-                            exec_result <= pc + 4;
+                            exec_result <= pc_seq;
                             next_pc <= pc + imm_j;
                             write_rd <= 1;
                             state <= STATE_WRITEBACK;
                         end
 
                         OP_JALR: begin
-                            exec_result <= pc + 4;
+                            exec_result <= pc_seq;
                             next_pc <= (rs1_val + imm_i) & ~32'h1;
                             write_rd <= 1;
                             state <= STATE_WRITEBACK;
@@ -325,12 +477,24 @@ module cpu(
 
                         OP_IMM, OP_REG: begin
                             // alu_result is valid combinationally
-                            exec_result <= alu_result;
+                            exec_result <= is_muldiv ? mul_result : alu_result;
                             write_rd <= 1;
-                            state <= STATE_WRITEBACK;
+                            state <= (is_muldiv && funct3[2]) ? STATE_DIVIDE : STATE_WRITEBACK;
                         end
 
-                        OP_FENCE, OP_SYSTEM: begin
+                        OP_SYSTEM: begin
+                            if (is_csr) begin
+                                exec_result <= csr_rdata;
+                                write_rd <= 1;
+                            end
+                            if (is_mret)
+                                next_pc <= csr_mepc;
+                            // WFI waits here until an enabled interrupt is pending
+                            if (!is_wfi || csr_wfi_wake)
+                                state <= STATE_WRITEBACK;
+                        end
+
+                        OP_FENCE: begin
                             state <= STATE_WRITEBACK;
                         end
 
@@ -342,7 +506,7 @@ module cpu(
 
                 // Complete stores after one bus cycle. Loads wait an additional
                 // cycle so synchronous block RAM can register its read output.
-                STATE_MEMORY: begin
+                STATE_MEMORY: if (mem_ready) begin
                     mem_re <= 0;
                     mem_we <= 0;
                     mem_wstrb <= 4'b0000;
@@ -360,6 +524,13 @@ module cpu(
                     state <= STATE_WRITEBACK;
                 end
 
+                STATE_DIVIDE: begin
+                    if (div_done) begin
+                        exec_result <= div_result;
+                        state <= STATE_WRITEBACK;
+                    end
+                end
+
                 // Write result to register file, update PC
                 STATE_WRITEBACK: begin
                     if (write_rd && rd != 5'd0)
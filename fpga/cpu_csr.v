@@ -0,0 +1,198 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Machine-mode CSRs and trap state shared by both CPU cores.
+// Implements mstatus (MIE, MPIE), mie, mtvec (direct mode), mscratch, mepc,
+// mcause and a read-only mip with the timer (MTIP) and external (MEIP)
+// interrupt lines, plus 64-bit counters: mcycle, minstret and mhpmcounter3-10
+// counting the hpm_event strobes, with read-only cycle, instret and
+// hpmcounter copies. Other CSR addresses read as zero and ignore writes.
+module cpu_csr #(
+    parameter integer HPM_COUNTERS = 8
+) (
+    input wire clk,
+    input wire rst,
+
+    // CSR instruction: rdata is the old value, the write happens at the edge
+    // when we is set. op is funct3[1:0]: 01 write, 10 set, 11 clear.
+    input wire [11:0] addr,
+    input wire we,
+    input wire [1:0] op,
+    input wire [31:0] src,
+    output reg [31:0] rdata,
+
+    // Trap entry (exception or interrupt) and MRET, one cycle strobes
+    input wire trap,
+    input wire [31:0] trap_pc,
+    input wire [31:0] trap_cause,
+    input wire mret,
+    output wire [31:0] mtvec,
+    output wire [31:0] mepc,
+
+    // Interrupt lines and the resulting requests
+    input wire timer_irq,
+    input wire external_irq,
+    output wire irq_pending,     // an enabled interrupt should be taken now
+    output wire [31:0] irq_cause,
+    output wire wfi_wake,        // an interrupt enabled in mie is pending
+
+    // Performance events, counted once per cycle they are set: instret for
+    // a retired instruction, hpm_event[n] in mhpmcounter(n + 3)
+    input wire instret,
+    input wire [HPM_COUNTERS - 1:0] hpm_event
+);
+    localparam CSR_MSTATUS  = 12'h300,
+               CSR_MIE      = 12'h304,
+               CSR_MTVEC    = 12'h305,
+               CSR_MSCRATCH = 12'h340,
+               CSR_MEPC     = 12'h341,
+               CSR_MCAUSE   = 12'h342,
+               CSR_MIP      = 12'h344;
+
+    // Counter CSRs: 0xB00 + n machine (read/write), 0xC00 + n user
+    // (read-only); bit 7 selects the high half. n = 0 cycle, 2 instret,
+    // 3 and up the event counters.
+    localparam COUNTER_CYCLE   = 5'd0,
+               COUNTER_INSTRET = 5'd2,
+               COUNTER_HPM     = 5'd3;
+
+    reg mstatus_mie;
+    reg mstatus_mpie;
+    reg mie_mtie;
+    reg mie_meie;
+    reg [29:0] mtvec_base;
+    reg [31:0] mscratch;
+    reg [30:0] mepc_reg;
+    reg [31:0] mcause;
+
+    wire [31:0] mstatus = {19'b0, 2'b11, 3'b0, mstatus_mpie, 3'b0, mstatus_mie, 3'b0};
+    wire [31:0] mie = {20'b0, mie_meie, 3'b0, mie_mtie, 7'b0};
+    wire [31:0] mip = {20'b0, external_irq, 3'b0, timer_irq, 7'b0};
+
+    assign mtvec = {mtvec_base, 2'b00};
+    assign mepc = {mepc_reg, 1'b0};
+
+    // External interrupts take priority over the timer
+    assign wfi_wake = (mie_meie && external_irq) || (mie_mtie && timer_irq);
+    assign irq_pending = mstatus_mie && wfi_wake;
+    assign irq_cause = (mie_meie && external_irq) ? 32'h8000000B : 32'h80000007;
+
+    reg [63:0] mcycle;
+    reg [63:0] minstret;
+    reg [64 * HPM_COUNTERS - 1:0] mhpmcounter;
+
+    wire is_counter = (addr[11:8] == 4'hB || addr[11:8] == 4'hC) && addr[6:5] == 2'b00;
+    wire [4:0] counter_index = addr[4:0];
+    wire counter_is_hpm = counter_index >= COUNTER_HPM &&
+                          counter_index < COUNTER_HPM + HPM_COUNTERS;
+    wire [4:0] hpm_index = counter_index - COUNTER_HPM;
+    reg [63:0] counter;
+    always @(*) begin
+        if (counter_index == COUNTER_CYCLE)
+            counter = mcycle;
+        else if (counter_index == COUNTER_INSTRET)
+            counter = minstret;
+        else if (counter_is_hpm)
+            counter = mhpmcounter[hpm_index * 64 +: 64];
+        else
+            counter = 64'b0;
+    end
+
+    always @(*) begin
+        case (addr)
+            CSR_MSTATUS:  rdata = mstatus;
+            CSR_MIE:      rdata = mie;
+            CSR_MTVEC:    rdata = mtvec;
+            CSR_MSCRATCH: rdata = mscratch;
+            CSR_MEPC:     rdata = mepc;
+            CSR_MCAUSE:   rdata = mcause;
+            CSR_MIP:      rdata = mip;
+            default:      rdata = !is_counter ? 32'b0 :
+                                  addr[7] ? counter[63:32] : counter[31:0];
+        endcase
+    end
+
+    reg [31:0] wdata;
+    always @(*) begin
+        case (op)
+            2'b10:   wdata = rdata | src;
+            2'b11:   wdata = rdata & ~src;
+            default: wdata = src;
+        endcase
+    end
+
+    always @(posedge clk) begin
+        if (rst) begin
+            mstatus_mie <= 0;
+            mstatus_mpie <= 0;
+            mie_mtie <= 0;
+            mie_meie <= 0;
+            mtvec_base <= 30'b0;
+            mscratch <= 32'b0;
+            mepc_reg <= 31'b0;
+            mcause <= 32'b0;
+        end else if (trap) begin
+            mepc_reg <= trap_pc[31:1];
+            mcause <= trap_cause;
+            mstatus_mpie <= mstatus_mie;
+            mstatus_mie <= 0;
+        end else if (mret) begin
+            mstatus_mie <= mstatus_mpie;
+            mstatus_mpie <= 1;
+        end else if (we) begin
+            case (addr)
+                CSR_MSTATUS: begin
+                    mstatus_mie <= wdata[3];
+                    mstatus_mpie <= wdata[7];
+                end
+                CSR_MIE: begin
+                    mie_mtie <= wdata[7];
+                    mie_meie <= wdata[11];
+                end
+                CSR_MTVEC:    mtvec_base <= wdata[31:2];
+                CSR_MSCRATCH: mscratch <= wdata;
+                CSR_MEPC:     mepc_reg <= wdata[31:1];
+                CSR_MCAUSE:   mcause <= wdata;
+                default: ;
+            endcase
+        end
+    end
+
+    // A counter write replaces the increment of that cycle
+    wire counter_we = we && addr[11:8] == 4'hB && is_counter;
+    integer i;
+    always @(posedge clk) begin
+        if (rst) begin
+            mcycle <= 64'b0;
+            minstret <= 64'b0;
+            mhpmcounter <= {(64 * HPM_COUNTERS){1'b0}};
+        end else begin
+            mcycle <= mcycle + 64'd1;
+            if (instret)
+                minstret <= minstret + 64'd1;
+            for (i = 0; i < HPM_COUNTERS; i = i + 1) begin
+                if (hpm_event[i])
+                    mhpmcounter[i * 64 +: 64] <= mhpmcounter[i * 64 +: 64] + 64'd1;
+            end
+
+            if (counter_we) begin
+                if (counter_index == COUNTER_CYCLE) begin
+                    if (addr[7])
+                        mcycle[63:32] <= wdata;
+                    else
+                        mcycle[31:0] <= wdata;
+                end else if (counter_index == COUNTER_INSTRET) begin
+                    if (addr[7])
+                        minstret[63:32] <= wdata;
+                    else
+                        minstret[31:0] <= wdata;
+                end else if (counter_is_hpm) begin
+                    mhpmcounter[hpm_index * 64 + (addr[7] ? 32 : 0) +: 32] <= wdata;
+                end
+            end
+        end
+    end
+endmodule
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// RV32M DIV/DIVU/REM/REMU unit shared by both CPU cores.
+// Restoring division on the operand magnitudes, one quotient bit per clock:
+// start is sampled for one cycle, done pulses 32 cycles later and result then
+// holds until the next start. Division by zero and signed overflow return the
+// values required by the RISC-V specification without special timing.
+module cpu_divider(
+    input wire clk,
+    input wire rst,
+    input wire start,
+    input wire [1:0] op, // funct3[1:0]: 00 DIV, 01 DIVU, 10 REM, 11 REMU
+    input wire [31:0] dividend,
+    input wire [31:0] divisor,
+    output reg busy,
+    output reg done,
+    output wire [31:0] result
+);
+    reg [31:0] quotient;
+    reg [31:0] remainder;
+    reg [31:0] divisor_abs;
+    reg [4:0] count;
+    reg negate_quotient;
+    reg negate_remainder;
+    reg want_remainder;
+
+    wire is_signed = !op[0];
+    wire dividend_neg = is_signed && dividend[31];
+    wire divisor_neg = is_signed && divisor[31];
+
+    // Shift the next dividend bit into the partial remainder and subtract
+    wire [32:0] trial = {remainder, quotient[31]} - {1'b0, divisor_abs};
+
+    always @(posedge clk) begin
+        if (rst) begin
+            busy <= 0;
+            done <= 0;
+            count <= 0;
+            quotient <= 32'b0;
+            remainder <= 32'b0;
+            divisor_abs <= 32'b0;
+            negate_quotient <= 0;
+            negate_remainder <= 0;
+            want_remainder <= 0;
+        end else begin
+            done <= 0;
+            if (start) begin
+                quotient <= dividend_neg ? -dividend : dividend;
+                remainder <= 32'b0;
+                divisor_abs <= divisor_neg ? -divisor : divisor;
+                // x / 0 yields all ones and x % 0 yields x
+                negate_quotient <= (dividend_neg ^ divisor_neg) && divisor != 32'b0;
+                negate_remainder <= dividend_neg;
+                want_remainder <= op[1];
+                count <= 5'd31;
+                busy <= 1;
+            end else if (busy) begin
+                if (!trial[32]) begin
+                    remainder <= trial[31:0];
+                    quotient <= {quotient[30:0], 1'b1};
+                end else begin
+                    remainder <= {remainder[30:0], quotient[31]};
+                    quotient <= {quotient[30:0], 1'b0};
+                end
+                count <= count - 1'b1;
+                if (count == 5'd0) begin
+                    busy <= 0;
+                    done <= 1;
+                end
+            end
+        end
+    end
+
+    assign result = want_remainder ?
+        (negate_remainder ? -remainder : remainder) :
+        (negate_quotient ? -quotient : quotient);
+endmodule
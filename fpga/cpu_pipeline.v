@@ -0,0 +1,594 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// RV32IMC five-stage pipelined CPU (fetch, decode, execute, memory, writeback)
+// Same data bus and ISA subset as cpu.v, plus a separate instruction port.
+// Decode expands compressed instructions with cpu_rvc; a 32-bit instruction
+// that straddles a word boundary costs one bubble to fetch its upper half.
+// Operands are forwarded from the memory, writeback and retired stages, so
+// dependent ALU instructions issue back to back. JAL and backward branches
+// are predicted taken in decode, forward branches not taken; a misprediction
+// or JALR costs one bubble. Loads hold the memory stage for a second cycle
+// because the bus returns read data one cycle after the request. Multiplies
+// complete in execute; divides hold execute until the divider finishes.
+// Traps are taken in execute: exceptions on the instruction there, interrupts
+// in place of it, so mepc is that instruction's PC. WFI holds execute until an
+// enabled interrupt is pending.
+// Performance counters: instructions retire as they leave execute;
+// mhpmcounter3 memory stall cycles, 4 stores, 5 taken branches, 6-10 data
+// bus cycles per bus_region (UART, Taro, RAM, ROM, PSRAM). Instruction
+// fetches use their own port and are not counted per region.
+module cpu_pipeline(
+    input wire clk,
+    input wire rst,
+
+    // Instruction port: synchronous read, imem_rdata holds the word
+    // addressed by imem_addr in the previous cycle
+    output wire [31:0] imem_addr,
+    input wire [31:0] imem_rdata,
+
+    // Memory bus: drive addr/data/control in one cycle,
+    // response (mem_rdata) available next cycle. A device that needs longer
+    // holds mem_ready low, which stalls the memory stage with the request
+    // still driven.
+    output reg [31:0] mem_addr,
+    output reg [31:0] mem_wdata,
+    input wire [31:0] mem_rdata,
+    input wire mem_ready,
+    output reg mem_we,
+    output reg mem_re,
+    output reg [3:0] mem_wstrb,
+
+    // Level-sensitive interrupt lines (mip.MTIP and mip.MEIP)
+    input wire timer_irq,
+    input wire external_irq,
+
+    // SoC address decode of mem_addr for the performance counters, one-hot:
+    // bit 0 UART, 1 Taro, 2 RAM, 3 ROM, 4 PSRAM
+    input wire [4:0] bus_region
+);
+
+    // Opcodes
+    localparam OP_LUI    = 7'b0110111,
+               OP_AUIPC  = 7'b0010111,
+               OP_JAL    = 7'b1101111,
+               OP_JALR   = 7'b1100111,
+               OP_BRANCH = 7'b1100011,
+               OP_LOAD   = 7'b0000011,
+               OP_STORE  = 7'b0100011,
+               OP_IMM    = 7'b0010011,
+               OP_REG    = 7'b0110011,
+               OP_FENCE  = 7'b0001111,
+               OP_SYSTEM = 7'b1110011;
+
+    // ALU operations
+    localparam ALU_ADD  = 4'd0,
+               ALU_SUB  = 4'd1,
+               ALU_SLL  = 4'd2,
+               ALU_SLT  = 4'd3,
+               ALU_SLTU = 4'd4,
+               ALU_XOR  = 4'd5,
+               ALU_SRL  = 4'd6,
+               ALU_SRA  = 4'd7,
+               ALU_OR   = 4'd8,
+               ALU_AND  = 4'd9;
+
+    (* syn_ramstyle = "block_ram" *) reg [31:0] regs [0:31];
+
+    // Pipeline control. A stall holds fetch, decode and execute in place;
+    // a redirect from execute squashes the instruction in decode.
+    wire stall;
+    wire e_redirect;
+    wire [31:0] e_redirect_pc;
+
+    // === Fetch / decode ===
+    reg [31:0] d_pc;
+    reg d_have_low;    // lower half of a straddling instruction is in d_low
+    reg [15:0] d_low;  // and imem_rdata holds the word at d_pc + 2
+
+    wire [15:0] d_half = d_pc[1] ? imem_rdata[31:16] : imem_rdata[15:0];
+    wire d_compressed = !d_have_low && d_half[1:0] != 2'b11;
+    wire d_split = !d_have_low && d_pc[1] && d_half[1:0] == 2'b11;
+    wire [31:0] d_word_pc = d_have_low ? d_pc + 2 : d_pc;
+
+    wire [31:0] d_expanded;
+    wire d_illegal;
+    cpu_rvc rvc(
+        .cinstr(d_half),
+        .instr(d_expanded),
+        .illegal(d_illegal)
+    );
+
+    wire [31:0] d_instr = d_have_low   ? {imem_rdata[15:0], d_low} :
+                          d_compressed ? d_expanded : imem_rdata;
+    wire [6:0] d_opcode = d_instr[6:0];
+    wire [4:0] d_rs1    = d_instr[19:15];
+    wire [4:0] d_rs2    = d_instr[24:20];
+
+    wire [31:0] d_imm_b = {{19{d_instr[31]}}, d_instr[31], d_instr[7], d_instr[30:25], d_instr[11:8], 1'b0};
+    wire [31:0] d_imm_j = {{11{d_instr[31]}}, d_instr[31], d_instr[19:12], d_instr[20], d_instr[30:21], 1'b0};
+
+    // Static prediction: JAL always taken, branches taken when backward
+    wire d_predict_taken = (d_opcode == OP_JAL) || (d_opcode == OP_BRANCH && d_imm_b[31]);
+    wire [31:0] d_next_pc = d_predict_taken ?
+        d_pc + (d_opcode == OP_JAL ? d_imm_j : d_imm_b) : d_pc + (d_compressed ? 2 : 4);
+
+    // The block RAM registers imem_addr, so the next instruction arrives
+    // together with the PC latched into d_pc at the same edge. A stall
+    // re-reads the word decode is holding; a split instruction reads the
+    // word after it while d_pc stays put.
+    wire [31:0] fetch_pc = rst        ? 32'h00000000 :
+                           e_redirect ? e_redirect_pc :
+                           stall      ? d_word_pc :
+                           d_split    ? d_pc + 2 : d_next_pc;
+    assign imem_addr = fetch_pc;
+
+    // === Execute ===
+    reg e_valid;
+    reg [31:0] e_pc;
+    reg [31:0] e_instr;
+    reg e_predicted_taken;
+    reg e_compressed;
+    reg e_rvc_illegal;
+    wire [6:0] e_opcode = e_instr[6:0];
+    wire [4:0] e_rd     = e_instr[11:7];
+    wire [2:0] e_funct3 = e_instr[14:12];
+    wire [4:0] e_rs1    = e_instr[19:15];
+    wire [4:0] e_rs2    = e_instr[24:20];
+    wire [6:0] e_funct7 = e_instr[31:25];
+
+    wire [31:0] e_imm_i = {{20{e_instr[31]}}, e_instr[31:20]};
+    wire [31:0] e_imm_s = {{20{e_instr[31]}}, e_instr[31:25], e_instr[11:7]};
+    wire [31:0] e_imm_b = {{19{e_instr[31]}}, e_instr[31], e_instr[7], e_instr[30:25], e_instr[11:8], 1'b0};
+    wire [31:0] e_imm_u = {e_instr[31:12], 12'b0};
+    wire [31:0] e_imm_j = {{11{e_instr[31]}}, e_instr[31], e_instr[19:12], e_instr[20], e_instr[30:21], 1'b0};
+
+    // System instructions
+    wire e_is_csr    = e_opcode == OP_SYSTEM && e_funct3[1:0] != 2'b00;
+    wire e_is_ecall  = e_instr == 32'h00000073;
+    wire e_is_ebreak = e_instr == 32'h00100073;
+    wire e_is_mret   = e_instr == 32'h30200073;
+    wire e_is_wfi    = e_instr == 32'h10500073;
+
+    wire e_writes_rd = e_rd != 5'd0 &&
+        (e_opcode == OP_LUI || e_opcode == OP_AUIPC || e_opcode == OP_JAL ||
+         e_opcode == OP_JALR || e_opcode == OP_LOAD || e_opcode == OP_IMM ||
+         e_opcode == OP_REG || e_is_csr);
+
+    // Synchronous register file read. Decode addresses it normally; during a
+    // stall it re-reads the execute operands so that writes retiring while
+    // execute waits are picked up.
+    reg [31:0] rs1_q, rs2_q;
+    wire [4:0] rf_raddr1 = stall ? e_rs1 : d_rs1;
+    wire [4:0] rf_raddr2 = stall ? e_rs2 : d_rs2;
+    always @(posedge clk) begin
+        rs1_q <= regs[rf_raddr1];
+        rs2_q <= regs[rf_raddr2];
+    end
+
+    // === Memory and writeback stage registers ===
+    reg m_valid;
+    reg m_writes_rd;
+    reg [4:0] m_rd;
+    reg [31:0] m_result;
+    reg m_load;
+    reg m_load_ready; // second memory cycle of a load: mem_rdata is valid
+    reg [2:0] m_funct3;
+    reg [1:0] m_addr_lo;
+
+    reg w_valid;
+    reg w_writes_rd;
+    reg [4:0] w_rd;
+    reg [31:0] w_result;
+
+    // Retired: the instruction whose register write happened at the last
+    // edge, which the block RAM read at that same edge could not yet see.
+    reg r_valid;
+    reg [4:0] r_rd;
+    reg [31:0] r_result;
+
+    // Load data selection from word-aligned read (combinational)
+    reg [31:0] load_result;
+    always @(*) begin
+        case (m_funct3)
+            3'b000: begin // LB
+                case (m_addr_lo)
+                    2'b00: load_result = {{24{mem_rdata[7]}},  mem_rdata[7:0]};
+                    2'b01: load_result = {{24{mem_rdata[15]}}, mem_rdata[15:8]};
+                    2'b10: load_result = {{24{mem_rdata[23]}}, mem_rdata[23:16]};
+                    2'b11: load_result = {{24{mem_rdata[31]}}, mem_rdata[31:24]};
+                endcase
+            end
+            3'b001: begin // LH
+                if (m_addr_lo[1])
+                    load_result = {{16{mem_rdata[31]}}, mem_rdata[31:16]};
+                else
+                    load_result = {{16{mem_rdata[15]}}, mem_rdata[15:0]};
+            end
+            3'b010: load_result = mem_rdata; // LW
+            3'b100: begin // LBU
+                case (m_addr_lo)
+                    2'b00: load_result = {24'b0, mem_rdata[7:0]};
+                    2'b01: load_result = {24'b0, mem_rdata[15:8]};
+                    2'b10: load_result = {24'b0, mem_rdata[23:16]};
+                    2'b11: load_result = {24'b0, mem_rdata[31:24]};
+                endcase
+            end
+            3'b101: begin // LHU
+                if (m_addr_lo[1])
+                    load_result = {16'b0, mem_rdata[31:16]};
+                else
+                    load_result = {16'b0, mem_rdata[15:0]};
+            end
+            default: load_result = mem_rdata;
+        endcase
+    end
+
+    wire [31:0] m_forward = m_load ? load_result : m_result;
+
+    // A load occupies the memory stage for two cycles, and any access stays
+    // there while the bus holds it
+    wire m_bus_wait = (mem_re || mem_we) && !mem_ready;
+    wire m_stall = m_valid && (m_bus_wait || (m_load && !m_load_ready));
+
+    // A divide occupies the execute stage until its result is ready
+    wire e_is_muldiv = (e_opcode == OP_REG) && (e_funct7 == 7'b0000001);
+    wire e_is_div = e_is_muldiv && e_funct3[2];
+    wire div_busy, div_done;
+    wire [31:0] div_result;
+    reg div_finished; // result held for a divide waiting on a memory stall
+    wire div_ready = div_finished || div_done;
+    wire csr_wfi_wake;
+    wire e_stall = e_valid && ((e_is_div && !div_ready) || (e_is_wfi && !csr_wfi_wake));
+
+    assign stall = m_stall || e_stall;
+
+    // === Operand forwarding (newest producer wins) ===
+    reg [31:0] rs1_val, rs2_val;
+    always @(*) begin
+        if (e_rs1 == 5'd0)
+            rs1_val = 32'b0;
+        else if (m_valid && m_writes_rd && m_rd == e_rs1)
+            rs1_val = m_forward;
+        else if (w_valid && w_writes_rd && w_rd == e_rs1)
+            rs1_val = w_result;
+        else if (r_valid && r_rd == e_rs1)
+            rs1_val = r_result;
+        else
+            rs1_val = rs1_q;
+
+        if (e_rs2 == 5'd0)
+            rs2_val = 32'b0;
+        else if (m_valid && m_writes_rd && m_rd == e_rs2)
+            rs2_val = m_forward;
+        else if (w_valid && w_writes_rd && w_rd == e_rs2)
+            rs2_val = w_result;
+        else if (r_valid && r_rd == e_rs2)
+            rs2_val = r_result;
+        else
+            rs2_val = rs2_q;
+    end
+
+    // ALU - fully combinational, driven by forwarded operands and instruction
+    reg [31:0] alu_a, alu_b;
+    reg [3:0] alu_op;
+    reg [31:0] alu_result;
+
+    always @(*) begin
+        alu_a = rs1_val;
+        alu_b = 32'b0;
+        alu_op = ALU_ADD;
+
+        case (e_opcode)
+            OP_IMM: begin
+                alu_b = e_imm_i;
+                case (e_funct3)
+                    3'b000: alu_op = ALU_ADD;
+                    3'b010: alu_op = ALU_SLT;
+                    3'b011: alu_op = ALU_SLTU;
+                    3'b100: alu_op = ALU_XOR;
+                    3'b110: alu_op = ALU_OR;
+                    3'b111: alu_op = ALU_AND;
+                    3'b001: alu_op = ALU_SLL;
+                    3'b101: alu_op = (e_funct7[5]) ? ALU_SRA : ALU_SRL;
+                    default: alu_op = ALU_ADD;
+                endcase
+            end
+            OP_REG: begin
+                alu_b = rs2_val;
+                case (e_funct3)
+                    3'b000: alu_op = (e_funct7[5]) ? ALU_SUB : ALU_ADD;
+                    3'b001: alu_op = ALU_SLL;
+                    3'b010: alu_op = ALU_SLT;
+                    3'b011: alu_op = ALU_SLTU;
+                    3'b100: alu_op = ALU_XOR;
+                    3'b101: alu_op = (e_funct7[5]) ? ALU_SRA : ALU_SRL;
+                    3'b110: alu_op = ALU_OR;
+                    3'b111: alu_op = ALU_AND;
+                    default: alu_op = ALU_ADD;
+                endcase
+            end
+            OP_LOAD: begin
+                alu_b = e_imm_i;
+            end
+            OP_STORE: begin
+                alu_b = e_imm_s;
+            end
+            default: ;
+        endcase
+    end
+
+    always @(*) begin
+        case (alu_op)
+            ALU_ADD:  alu_result = alu_a + alu_b;
+            ALU_SUB:  alu_result = alu_a - alu_b;
+            ALU_SLL:  alu_result = alu_a << alu_b[4:0];
+            ALU_SLT:  alu_result = {31'b0, $signed(alu_a) < $signed(alu_b)};
+            ALU_SLTU: alu_result = {31'b0, alu_a < alu_b};
+            ALU_XOR:  alu_result = alu_a ^ alu_b;
+            ALU_SRL:  alu_result = alu_a >> alu_b[4:0];
+            ALU_SRA:  alu_result = $signed(alu_a) >>> alu_b[4:0];
+            ALU_OR:   alu_result = alu_a | alu_b;
+            ALU_AND:  alu_result = alu_a & alu_b;
+            default:  alu_result = 32'b0;
+        endcase
+    end
+
+    // 33x33 signed multiply covers MUL, MULH, MULHSU and MULHU (maps to DSP)
+    wire signed [32:0] mul_a = {(e_funct3 == 3'b001 || e_funct3 == 3'b010) && rs1_val[31], rs1_val};
+    wire signed [32:0] mul_b = {e_funct3 == 3'b001 && rs2_val[31], rs2_val};
+    wire signed [65:0] mul_product = mul_a * mul_b;
+    wire [31:0] mul_result = (e_funct3 == 3'b000) ? mul_product[31:0] : mul_product[63:32];
+
+    // Operands are only sampled once no older load is waiting for its data
+    cpu_divider divider(
+        .clk(clk),
+        .rst(rst),
+        .start(e_valid && e_is_div && !div_busy && !div_ready && !m_stall),
+        .op(e_funct3[1:0]),
+        .dividend(rs1_val),
+        .divisor(rs2_val),
+        .busy(div_busy),
+        .done(div_done),
+        .result(div_result)
+    );
+
+    // Branch comparison
+    reg branch_taken;
+    always @(*) begin
+        case (e_funct3)
+            3'b000:  branch_taken = (rs1_val == rs2_val);                   // BEQ
+            3'b001:  branch_taken = (rs1_val != rs2_val);                   // BNE
+            3'b100:  branch_taken = ($signed(rs1_val) < $signed(rs2_val));  // BLT
+            3'b101:  branch_taken = ($signed(rs1_val) >= $signed(rs2_val)); // BGE
+            3'b110:  branch_taken = (rs1_val < rs2_val);                    // BLTU
+            3'b111:  branch_taken = (rs1_val >= rs2_val);                   // BGEU
+            default: branch_taken = 0;
+        endcase
+    end
+
+    // Exceptions and interrupts. An interrupt is not taken on WFI itself, so
+    // it returns to the instruction after it.
+    reg e_illegal;
+    always @(*) begin
+        case (e_opcode)
+            OP_LUI, OP_AUIPC, OP_JAL, OP_JALR, OP_BRANCH, OP_LOAD, OP_STORE,
+            OP_IMM, OP_REG, OP_FENCE:
+                e_illegal = e_rvc_illegal;
+            OP_SYSTEM:
+                e_illegal = !(e_is_csr || e_is_ecall || e_is_ebreak || e_is_mret || e_is_wfi);
+            default:
+                e_illegal = 1;
+        endcase
+    end
+    wire e_exception = e_illegal || e_is_ecall || e_is_ebreak;
+    wire [31:0] e_exception_cause = e_illegal ? 32'd2 : e_is_ecall ? 32'd11 : 32'd3;
+
+    wire csr_irq_pending;
+    wire [31:0] csr_rdata, csr_mtvec, csr_mepc, csr_irq_cause;
+    wire e_interrupt = csr_irq_pending && !e_is_wfi;
+    wire e_trap = e_valid && (e_exception || e_interrupt);
+    wire e_commit = e_valid && !e_trap;
+
+    // CSRRS/CSRRC with rs1 = x0 (or a zero immediate) only read
+    cpu_csr csr(
+        .clk(clk),
+        .rst(rst),
+        .addr(e_instr[31:20]),
+        .we(e_commit && !stall && e_is_csr && !(e_funct3[1] && e_rs1 == 5'd0)),
+        .op(e_funct3[1:0]),
+        .src(e_funct3[2] ? {27'b0, e_rs1} : rs1_val),
+        .rdata(csr_rdata),
+        .trap(e_trap && !stall),
+        .trap_pc(e_pc),
+        .trap_cause(e_interrupt ? csr_irq_cause : e_exception_cause),
+        .mret(e_commit && !stall && e_is_mret),
+        .mtvec(csr_mtvec),
+        .mepc(csr_mepc),
+        .timer_irq(timer_irq),
+        .external_irq(external_irq),
+        .irq_pending(csr_irq_pending),
+        .irq_cause(csr_irq_cause),
+        .wfi_wake(csr_wfi_wake),
+        .instret(e_commit && !stall),
+        .hpm_event({
+            {5{(m_valid && m_load) || mem_we}} & bus_region,
+            e_commit && !stall && e_opcode == OP_BRANCH && branch_taken,
+            e_commit && !stall && e_opcode == OP_STORE,
+            m_stall
+        })
+    );
+
+    // Address of the sequential next instruction, also the link address
+    wire [31:0] e_pc_seq = e_pc + (e_compressed ? 32'd2 : 32'd4);
+
+    // Result and control-flow resolution
+    reg [31:0] e_result;
+    reg e_mispredict;
+    reg [31:0] e_correct_pc;
+    always @(*) begin
+        e_result = e_is_muldiv ? (e_funct3[2] ? div_result : mul_result) : alu_result;
+        e_mispredict = 0;
+        e_correct_pc = e_pc_seq;
+
+        case (e_opcode)
+            OP_LUI:   e_result = e_imm_u;
+            OP_AUIPC: e_result = e_pc + e_imm_u;
+            OP_JAL:   e_result = e_pc_seq;
+            OP_JALR: begin
+                e_result = e_pc_seq;
+                e_mispredict = 1;
+                e_correct_pc = (rs1_val + e_imm_i) & ~32'h1;
+            end
+            OP_BRANCH: begin
+                e_mispredict = branch_taken != e_predicted_taken;
+                if (branch_taken)
+                    e_correct_pc = e_pc + e_imm_b;
+            end
+            OP_SYSTEM: begin
+                if (e_is_csr)
+                    e_result = csr_rdata;
+                if (e_is_mret) begin
+                    e_mispredict = 1;
+                    e_correct_pc = csr_mepc;
+                end
+            end
+            default: ;
+        endcase
+    end
+
+    assign e_redirect = e_valid && (e_mispredict || e_trap) && !stall;
+    assign e_redirect_pc = e_trap ? csr_mtvec : e_correct_pc;
+
+    // === Pipeline registers ===
+    always @(posedge clk) begin
+        if (rst) begin
+            d_pc <= 32'h00000000;
+            d_have_low <= 0;
+            d_low <= 16'b0;
+            e_valid <= 0;
+            e_pc <= 32'b0;
+            e_instr <= 32'b0;
+            e_predicted_taken <= 0;
+            e_compressed <= 0;
+            e_rvc_illegal <= 0;
+            m_valid <= 0;
+            m_writes_rd <= 0;
+            m_rd <= 5'b0;
+            m_result <= 32'b0;
+            m_load <= 0;
+            m_load_ready <= 0;
+            m_funct3 <= 3'b0;
+            m_addr_lo <= 2'b0;
+            w_valid <= 0;
+            w_writes_rd <= 0;
+            w_rd <= 5'b0;
+            w_result <= 32'b0;
+            r_valid <= 0;
+            r_rd <= 5'b0;
+            r_result <= 32'b0;
+            div_finished <= 0;
+            mem_we <= 0;
+            mem_re <= 0;
+            mem_wstrb <= 4'b0000;
+            mem_addr <= 32'b0;
+            mem_wdata <= 32'b0;
+            // regs initialised by BRAM to zero; no explicit reset loop needed
+        end else begin
+            // Writeback: commit to the register file, then remember the
+            // write for one cycle for the forwarding network.
+            if (w_valid && w_writes_rd)
+                regs[w_rd] <= w_result;
+            r_valid <= w_valid && w_writes_rd;
+            r_rd <= w_rd;
+            r_result <= w_result;
+
+            // Memory -> writeback
+            if (m_stall) begin
+                // First cycle of a load: the request has been seen by the bus
+                if (!m_bus_wait) begin
+                    m_load_ready <= 1;
+                    mem_re <= 0;
+                end
+                w_valid <= 0;
+            end else begin
+                w_valid <= m_valid;
+                w_writes_rd <= m_writes_rd;
+                w_rd <= m_rd;
+                w_result <= m_forward;
+            end
+
+            // Execute -> memory, and drive the bus for the next cycle; a
+            // trapping instruction does not continue
+            if (!stall) begin
+                m_valid <= e_commit;
+                m_writes_rd <= e_writes_rd;
+                m_rd <= e_rd;
+                m_result <= e_result;
+                m_load <= e_opcode == OP_LOAD;
+                m_load_ready <= 0;
+                m_funct3 <= e_funct3;
+                m_addr_lo <= alu_result[1:0];
+
+                mem_we <= 0;
+                mem_re <= 0;
+                mem_wstrb <= 4'b0000;
+                if (e_commit && e_opcode == OP_LOAD) begin
+                    mem_addr <= alu_result;
+                    mem_re <= 1;
+                end
+                if (e_commit && e_opcode == OP_STORE) begin
+                    mem_addr <= alu_result;
+                    mem_we <= 1;
+                    case (e_funct3)
+                        3'b000: begin // SB
+                            mem_wdata <= {4{rs2_val[7:0]}};
+                            mem_wstrb <= 4'b0001 << alu_result[1:0];
+                        end
+                        3'b001: begin // SH
+                            mem_wdata <= {2{rs2_val[15:0]}};
+                            mem_wstrb <= alu_result[1] ? 4'b1100 : 4'b0011;
+                        end
+                        default: begin // SW
+                            mem_wdata <= rs2_val;
+                            mem_wstrb <= 4'b1111;
+                        end
+                    endcase
+                end
+
+                // Decode -> execute; a redirect squashes the wrong-path
+                // instruction and a split instruction sends a bubble while
+                // decode keeps its lower half
+                e_valid <= !e_redirect && !d_split;
+                e_pc <= d_pc;
+                e_instr <= d_instr;
+                e_predicted_taken <= d_predict_taken;
+                e_compressed <= d_compressed;
+                e_rvc_illegal <= d_compressed && d_illegal;
+                if (d_split && !e_redirect) begin
+                    d_have_low <= 1;
+                    d_low <= d_half;
+                end else begin
+                    d_pc <= fetch_pc;
+                    d_have_low <= 0;
+                end
+                div_finished <= 0;
+            end else begin
+                if (div_done)
+                    div_finished <= 1;
+
+                // Execute is busy: send a bubble into the memory stage
+                if (!m_stall) begin
+                    m_valid <= 0;
+                    m_load <= 0;
+                    mem_we <= 0;
+                    mem_re <= 0;
+                    mem_wstrb <= 4'b0000;
+                end
+            end
+        end
+    end
+endmodule
@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// RV32C decompressor shared by both CPU cores.
+// Expands a 16-bit instruction into its 32-bit RV32I equivalent, so the rest
+// of the core only decodes 32-bit instructions. Floating-point forms, RV64/
+// RV128-only forms and reserved encodings set illegal and expand to a NOP.
+module cpu_rvc(
+    input wire [15:0] cinstr,
+    output reg [31:0] instr,
+    output reg illegal
+);
+    localparam OP_LUI    = 7'b0110111,
+               OP_JAL    = 7'b1101111,
+               OP_JALR   = 7'b1100111,
+               OP_BRANCH = 7'b1100011,
+               OP_LOAD   = 7'b0000011,
+               OP_STORE  = 7'b0100011,
+               OP_IMM    = 7'b0010011,
+               OP_REG    = 7'b0110011,
+               OP_SYSTEM = 7'b1110011;
+
+    localparam NOP = 32'h00000013;
+
+    wire [15:0] c = cinstr;
+
+    // Register fields: full 5-bit fields and the x8-x15 "prime" fields
+    wire [4:0] rd      = c[11:7];
+    wire [4:0] rs2     = c[6:2];
+    wire [4:0] rd_p    = {2'b01, c[4:2]};
+    wire [4:0] rs1_p   = {2'b01, c[9:7]};
+    wire [4:0] rs2_p   = {2'b01, c[4:2]};
+
+    // Immediates, extended to the width of the matching 32-bit format
+    wire [11:0] imm_ci        = {{6{c[12]}}, c[12], c[6:2]};
+    wire [11:0] imm_addi4spn  = {2'b00, c[10:7], c[12:11], c[5], c[6], 2'b00};
+    wire [11:0] imm_lw        = {5'b0, c[5], c[12:10], c[6], 2'b00};
+    wire [11:0] imm_addi16sp  = {{2{c[12]}}, c[12], c[4:3], c[5], c[2], c[6], 4'b0000};
+    wire [19:0] imm_lui       = {{14{c[12]}}, c[12], c[6:2]};
+    wire [11:0] imm_lwsp      = {4'b0, c[3:2], c[12], c[6:4], 2'b00};
+    wire [11:0] imm_swsp      = {4'b0, c[8:7], c[12:9], 2'b00};
+    wire [20:0] imm_j         = {{9{c[12]}}, c[12], c[8], c[10:9], c[6], c[7], c[2], c[11], c[5:3], 1'b0};
+    wire [12:0] imm_b         = {{4{c[12]}}, c[12], c[6:5], c[2], c[11:10], c[4:3], 1'b0};
+
+    // 32-bit encodings of the formats used by the expansions
+    wire [31:0] j_form = {imm_j[20], imm_j[10:1], imm_j[11], imm_j[19:12], 5'd0, OP_JAL};
+    wire [31:0] b_form = {imm_b[12], imm_b[10:5], 5'd0, rs1_p, 3'b000, imm_b[4:1], imm_b[11], OP_BRANCH};
+
+    always @(*) begin
+        instr = NOP;
+        illegal = 0;
+
+        case ({c[1:0], c[15:13]})
+            // Quadrant 0
+            5'b00_000: begin // C.ADDI4SPN
+                instr = {imm_addi4spn, 5'd2, 3'b000, rd_p, OP_IMM};
+                illegal = imm_addi4spn == 12'b0;
+            end
+            5'b00_010: // C.LW
+                instr = {imm_lw, rs1_p, 3'b010, rd_p, OP_LOAD};
+            5'b00_110: // C.SW
+                instr = {imm_lw[11:5], rs2_p, rs1_p, 3'b010, imm_lw[4:0], OP_STORE};
+
+            // Quadrant 1
+            5'b01_000: // C.ADDI, C.NOP
+                instr = {imm_ci, rd, 3'b000, rd, OP_IMM};
+            5'b01_001: // C.JAL
+                instr = {j_form[31:12], 5'd1, OP_JAL};
+            5'b01_010: // C.LI
+                instr = {imm_ci, 5'd0, 3'b000, rd, OP_IMM};
+            5'b01_011: begin
+                if (rd == 5'd2) begin // C.ADDI16SP
+                    instr = {imm_addi16sp, 5'd2, 3'b000, 5'd2, OP_IMM};
+                    illegal = imm_addi16sp == 12'b0;
+                end else begin // C.LUI
+                    instr = {imm_lui, rd, OP_LUI};
+                    illegal = imm_lui == 20'b0;
+                end
+            end
+            5'b01_100: begin
+                case (c[11:10])
+                    2'b00: begin // C.SRLI
+                        instr = {7'b0000000, c[6:2], rs1_p, 3'b101, rs1_p, OP_IMM};
+                        illegal = c[12];
+                    end
+                    2'b01: begin // C.SRAI
+                        instr = {7'b0100000, c[6:2], rs1_p, 3'b101, rs1_p, OP_IMM};
+                        illegal = c[12];
+                    end
+                    2'b10: // C.ANDI
+                        instr = {imm_ci, rs1_p, 3'b111, rs1_p, OP_IMM};
+                    2'b11: begin
+                        case (c[6:5])
+                            2'b00: instr = {7'b0100000, rs2_p, rs1_p, 3'b000, rs1_p, OP_REG}; // C.SUB
+                            2'b01: instr = {7'b0000000, rs2_p, rs1_p, 3'b100, rs1_p, OP_REG}; // C.XOR
+                            2'b10: instr = {7'b0000000, rs2_p, rs1_p, 3'b110, rs1_p, OP_REG}; // C.OR
+                            2'b11: instr = {7'b0000000, rs2_p, rs1_p, 3'b111, rs1_p, OP_REG}; // C.AND
+                        endcase
+                        illegal = c[12];
+                    end
+                endcase
+            end
+            5'b01_101: // C.J
+                instr = j_form;
+            5'b01_110: // C.BEQZ
+                instr = b_form;
+            5'b01_111: // C.BNEZ
+                instr = {b_form[31:15], 3'b001, b_form[11:0]};
+
+            // Quadrant 2
+            5'b10_000: begin // C.SLLI
+                instr = {7'b0000000, c[6:2], rd, 3'b001, rd, OP_IMM};
+                illegal = c[12];
+            end
+            5'b10_010: begin // C.LWSP
+                instr = {imm_lwsp, 5'd2, 3'b010, rd, OP_LOAD};
+                illegal = rd == 5'd0;
+            end
+            5'b10_100: begin
+                if (!c[12]) begin
+                    if (rs2 == 5'd0) begin // C.JR
+                        instr = {12'b0, rd, 3'b000, 5'd0, OP_JALR};
+                        illegal = rd == 5'd0;
+                    end else begin // C.MV
+                        instr = {7'b0000000, rs2, 5'd0, 3'b000, rd, OP_REG};
+                    end
+                end else begin
+                    if (rd == 5'd0 && rs2 == 5'd0) // C.EBREAK
+                        instr = {12'b000000000001, 5'd0, 3'b000, 5'd0, OP_SYSTEM};
+                    else if (rs2 == 5'd0) // C.JALR
+                        instr = {12'b0, rd, 3'b000, 5'd1, OP_JALR};
+                    else // C.ADD
+                        instr = {7'b0000000, rs2, rd, 3'b000, rd, OP_REG};
+                end
+            end
+            5'b10_110: // C.SWSP
+                instr = {imm_swsp[11:5], rs2, 5'd2, 3'b010, imm_swsp[4:0], OP_STORE};
+
+            default:
+                illegal = 1;
+        endcase
+
+        if (illegal)
+            instr = NOP;
+    end
+endmodule
@@ -0,0 +1,173 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Controller for the two 4 MB HyperBus PSRAM dies inside the GW1NR-9.
+// The dies run side by side on one command: die 0 holds bits 15:0 and die 1
+// bits 31:16 of every 32-bit word, so each CK edge moves two bytes and the
+// word address is also the 16-bit address inside each die.
+// CK runs at clk / 2 from a negedge flop, so it is centered in the bytes the
+// controller drives at posedge and read bytes, which the dies drive on CK,
+// are sampled half a clk later. A transfer is 6 command-address edges, a
+// fixed 2 x LATENCY CK cycle wait, then two edges per word: a read of
+// BURST_WORDS words or a write of one word, masked by RWDS with wstrb.
+// The dies power up with fixed latency and LATENCY 6, so no configuration
+// register writes are needed; start is ignored while busy.
+module psram #(
+    parameter integer LATENCY = 6,
+    parameter integer BURST_WORDS = 8,
+    parameter integer INIT_CYCLES = 4096   // > 150 us power-up wait at 27 MHz
+) (
+    input wire clk,
+    input wire rst,
+
+    // Transfer request, taken in the cycle start is high and busy is low
+    input wire start,
+    input wire write,
+    input wire [20:0] addr,         // word address, reads are not wrapped
+    input wire [31:0] wdata,
+    input wire [3:0] wstrb,
+    output wire busy,
+    output reg [31:0] rdata,
+    output reg rvalid,              // one pulse per word of a read burst
+
+    // Both dies, bit 0 (or byte 0) for die 0
+    output reg [1:0] psram_ck,
+    output wire [1:0] psram_ck_n,
+    output reg [1:0] psram_cs_n,
+    output reg [1:0] psram_reset_n,
+    output reg [15:0] psram_dq_out,
+    output reg psram_dq_oe,
+    input wire [15:0] psram_dq_in,
+    output reg [1:0] psram_rwds_out,
+    output reg psram_rwds_oe
+);
+    localparam integer CA_EDGES = 6;
+    localparam integer DATA_EDGE = CA_EDGES + 4 * LATENCY;
+    localparam integer READ_LAST = DATA_EDGE + 2 * BURST_WORDS - 1;
+    localparam integer WRITE_LAST = DATA_EDGE + 1;
+    localparam integer RECOVERY_CYCLES = 2;   // CS# high time between transfers
+
+    localparam STATE_INIT     = 2'd0,
+               STATE_IDLE     = 2'd1,
+               STATE_ACTIVE   = 2'd2,
+               STATE_RECOVERY = 2'd3;
+
+    reg [1:0] state;
+    reg [12:0] count;
+    reg [7:0] edge_index;           // CK edge the outputs are set up for
+    reg ck_run;
+    reg writing;
+    reg [47:0] ca;
+    reg [31:0] write_data;
+    reg [3:0] write_strb;
+    reg [15:0] read_high;           // first byte of each die for this word
+
+    assign busy = state != STATE_IDLE;
+    assign psram_ck_n = ~psram_ck;
+
+    always @(negedge clk) begin
+        psram_ck <= ck_run ? ~psram_ck : 2'b00;
+    end
+
+    always @(posedge clk) begin
+        if (rst) begin
+            state <= STATE_INIT;
+            count <= 0;
+            edge_index <= 0;
+            ck_run <= 0;
+            writing <= 0;
+            ca <= 48'b0;
+            write_data <= 32'b0;
+            write_strb <= 4'b0;
+            read_high <= 16'b0;
+            rdata <= 32'b0;
+            rvalid <= 0;
+            psram_cs_n <= 2'b11;
+            psram_reset_n <= 2'b00;
+            psram_dq_out <= 16'b0;
+            psram_dq_oe <= 0;
+            psram_rwds_out <= 2'b00;
+            psram_rwds_oe <= 0;
+        end else begin
+            rvalid <= 0;
+            psram_reset_n <= 2'b11;
+
+            case (state)
+                STATE_INIT: begin
+                    count <= count + 1;
+                    if (count == INIT_CYCLES - 1)
+                        state <= STATE_IDLE;
+                end
+
+                STATE_IDLE: begin
+                    if (start) begin
+                        // R/W#, memory space, linear burst, row and upper
+                        // column address, reserved, lower column address
+                        ca <= {!write, 1'b0, 1'b1, 11'b0, addr[20:3], 13'b0, addr[2:0]};
+                        writing <= write;
+                        write_data <= wdata;
+                        write_strb <= wstrb;
+                        psram_cs_n <= 2'b00;
+                        psram_dq_out <= {2{!write, 1'b0, 1'b1, 5'b0}};
+                        psram_dq_oe <= 1;
+                        ck_run <= 1;
+                        edge_index <= 0;
+                        state <= STATE_ACTIVE;
+                    end
+                end
+
+                STATE_ACTIVE: begin
+                    // The dies drove this edge's read byte half a clk ago
+                    if (!writing && edge_index >= DATA_EDGE) begin
+                        if (!edge_index[0]) begin
+                            read_high <= psram_dq_in;
+                        end else begin
+                            rdata <= {read_high[15:8], psram_dq_in[15:8],
+                                      read_high[7:0], psram_dq_in[7:0]};
+                            rvalid <= 1;
+                        end
+                    end
+
+                    if (edge_index == (writing ? WRITE_LAST : READ_LAST)) begin
+                        psram_cs_n <= 2'b11;
+                        psram_dq_oe <= 0;
+                        psram_rwds_oe <= 0;
+                        ck_run <= 0;
+                        count <= 0;
+                        state <= STATE_RECOVERY;
+                    end else begin
+                        // Set up the next edge
+                        edge_index <= edge_index + 1;
+                        if (edge_index + 1 < CA_EDGES) begin
+                            psram_dq_out <= {2{ca[39:32]}};
+                            ca <= {ca[39:0], 8'b0};
+                        end else if (edge_index + 1 < DATA_EDGE) begin
+                            psram_dq_oe <= 0;
+                        end else if (writing) begin
+                            // Each die sends its high byte first; RWDS high
+                            // masks a byte
+                            psram_dq_oe <= 1;
+                            psram_rwds_oe <= 1;
+                            if (edge_index + 1 == DATA_EDGE) begin
+                                psram_dq_out <= {write_data[31:24], write_data[15:8]};
+                                psram_rwds_out <= {!write_strb[3], !write_strb[1]};
+                            end else begin
+                                psram_dq_out <= {write_data[23:16], write_data[7:0]};
+                                psram_rwds_out <= {!write_strb[2], !write_strb[0]};
+                            end
+                        end
+                    end
+                end
+
+                STATE_RECOVERY: begin
+                    count <= count + 1;
+                    if (count == RECOVERY_CYCLES - 1)
+                        state <= STATE_IDLE;
+                end
+            endcase
+        end
+    end
+endmodule
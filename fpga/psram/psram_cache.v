@@ -0,0 +1,163 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Read-allocate, write-through cache for the PSRAM, with WAYS = 1 (direct
+// mapped) or 2 (LRU) ways of SETS lines of LINE_WORDS words.
+// The CPU side is the SoC bus with a ready line: a hit answers in the same
+// cycle like block RAM and rdata stays valid while addr is held. A miss holds
+// ready low while psram.v fills the whole line with one burst. Stores update
+// a hit line and go to a one-word write buffer, so they only wait while an
+// earlier store is still being written; a miss waits for the buffer to drain
+// so the fill sees every store.
+module psram_cache #(
+    parameter integer WAYS = 2,
+    parameter integer SETS = 64,
+    parameter integer LINE_WORDS = 8,
+    parameter integer ADDR_BITS = 21   // word address
+) (
+    input wire clk,
+    input wire rst,
+
+    // CPU side
+    input wire [ADDR_BITS - 1:0] addr,
+    input wire re,
+    input wire we,
+    input wire [31:0] wdata,
+    input wire [3:0] wstrb,
+    output wire [31:0] rdata,
+    output wire ready,
+
+    // psram.v side, with BURST_WORDS = LINE_WORDS
+    output wire mem_start,
+    output wire mem_write,
+    output wire [ADDR_BITS - 1:0] mem_addr,
+    output wire [31:0] mem_wdata,
+    output wire [3:0] mem_wstrb,
+    input wire mem_busy,
+    input wire [31:0] mem_rdata,
+    input wire mem_rvalid
+);
+    localparam integer OFFSET_BITS = $clog2(LINE_WORDS);
+    localparam integer INDEX_BITS = $clog2(SETS);
+    localparam integer TAG_BITS = ADDR_BITS - INDEX_BITS - OFFSET_BITS;
+
+    (* syn_ramstyle = "block_ram" *) reg [31:0] data0 [0:SETS * LINE_WORDS - 1];
+    (* syn_ramstyle = "block_ram" *) reg [31:0] data1 [0:SETS * LINE_WORDS - 1];
+    reg [TAG_BITS - 1:0] tag0 [0:SETS - 1];
+    reg [TAG_BITS - 1:0] tag1 [0:SETS - 1];
+    reg [SETS - 1:0] valid0;
+    reg [SETS - 1:0] valid1;
+    reg [SETS - 1:0] lru;   // way to replace next in a 2-way set
+
+    wire [OFFSET_BITS - 1:0] offset = addr[OFFSET_BITS - 1:0];
+    wire [INDEX_BITS - 1:0] index = addr[INDEX_BITS + OFFSET_BITS - 1:OFFSET_BITS];
+    wire [TAG_BITS - 1:0] tag = addr[ADDR_BITS - 1:INDEX_BITS + OFFSET_BITS];
+
+    wire hit0 = valid0[index] && tag0[index] == tag;
+    wire hit1 = WAYS == 2 && valid1[index] && tag1[index] == tag;
+    wire hit = hit0 || hit1;
+    assign rdata = hit1 ? data1[{index, offset}] : data0[{index, offset}];
+
+    // Line fill state
+    reg filling;
+    reg fill_way;
+    reg [OFFSET_BITS - 1:0] fill_offset;
+
+    // Write buffer
+    reg wb_valid;
+    reg [ADDR_BITS - 1:0] wb_addr;
+    reg [31:0] wb_data;
+    reg [3:0] wb_strb;
+
+    wire write_accept = we && !filling && !wb_valid;
+    assign ready = re ? (!filling && hit) : we ? write_accept : 1'b1;
+
+    // The buffered store goes first, then a read miss starts its fill
+    wire drain = wb_valid && !mem_busy;
+    wire fill_start = re && !filling && !hit && !wb_valid && !mem_busy;
+    wire victim = WAYS == 2 && lru[index];
+
+    assign mem_start = drain || fill_start;
+    assign mem_write = wb_valid;
+    assign mem_addr = wb_valid ? wb_addr : {tag, index, {OFFSET_BITS{1'b0}}};
+    assign mem_wdata = wb_data;
+    assign mem_wstrb = wb_strb;
+
+    // Data arrays: fill words, or a store into the line it hits
+    wire [INDEX_BITS + OFFSET_BITS - 1:0] write_index =
+        filling ? {index, fill_offset} : {index, offset};
+    wire [3:0] write_strb = filling ? 4'b1111 : wstrb;
+    wire [31:0] write_data = filling ? mem_rdata : wdata;
+    wire write0 = filling ? mem_rvalid && !fill_way : write_accept && hit0;
+    wire write1 = filling ? mem_rvalid && fill_way : write_accept && hit1;
+
+    always @(posedge clk) begin
+        if (write0) begin
+            if (write_strb[0]) data0[write_index][7:0] <= write_data[7:0];
+            if (write_strb[1]) data0[write_index][15:8] <= write_data[15:8];
+            if (write_strb[2]) data0[write_index][23:16] <= write_data[23:16];
+            if (write_strb[3]) data0[write_index][31:24] <= write_data[31:24];
+        end
+        if (write1) begin
+            if (write_strb[0]) data1[write_index][7:0] <= write_data[7:0];
+            if (write_strb[1]) data1[write_index][15:8] <= write_data[15:8];
+            if (write_strb[2]) data1[write_index][23:16] <= write_data[23:16];
+            if (write_strb[3]) data1[write_index][31:24] <= write_data[31:24];
+        end
+    end
+
+    always @(posedge clk) begin
+        if (rst) begin
+            valid0 <= {SETS{1'b0}};
+            valid1 <= {SETS{1'b0}};
+            lru <= {SETS{1'b0}};
+            filling <= 0;
+            fill_way <= 0;
+            fill_offset <= 0;
+            wb_valid <= 0;
+            wb_addr <= 0;
+            wb_data <= 32'b0;
+            wb_strb <= 4'b0;
+        end else begin
+            // A hit makes the other way the next victim
+            if (!filling && (re || we) && hit)
+                lru[index] <= hit0;
+
+            if (drain)
+                wb_valid <= 0;
+            if (write_accept) begin
+                wb_valid <= 1;
+                wb_addr <= addr;
+                wb_data <= wdata;
+                wb_strb <= wstrb;
+            end
+
+            // The CPU holds addr during the fill, so index and tag stay valid
+            if (fill_start) begin
+                filling <= 1;
+                fill_way <= victim;
+                fill_offset <= 0;
+                if (victim)
+                    valid1[index] <= 0;
+                else
+                    valid0[index] <= 0;
+            end
+            if (filling && mem_rvalid) begin
+                fill_offset <= fill_offset + 1;
+                if (fill_offset == LINE_WORDS - 1) begin
+                    filling <= 0;
+                    if (fill_way) begin
+                        tag1[index] <= tag;
+                        valid1[index] <= 1;
+                    end else begin
+                        tag0[index] <= tag;
+                        valid0[index] <= 1;
+                    end
+                end
+            end
+        end
+    end
+endmodule
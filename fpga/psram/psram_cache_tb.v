@@ -0,0 +1,217 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+`timescale 1ns/1ps
+
+module psram_cache_tb;
+    parameter integer WAYS = 2;
+
+    reg clk = 0;
+    reg rst = 1;
+    reg [20:0] addr = 0;
+    reg re = 0;
+    reg we = 0;
+    reg [31:0] wdata = 0;
+    reg [3:0] wstrb = 0;
+    wire [31:0] rdata;
+    wire ready;
+
+    wire mem_start, mem_write, mem_busy, mem_rvalid;
+    wire [20:0] mem_addr;
+    wire [31:0] mem_wdata, mem_rdata;
+    wire [3:0] mem_wstrb;
+
+    wire [1:0] psram_ck, psram_ck_n, psram_cs_n, psram_reset_n;
+    wire [15:0] psram_dq_out;
+    wire psram_dq_oe;
+    wire [1:0] psram_rwds_out;
+    wire psram_rwds_oe;
+    wire [7:0] die0_dq, die1_dq;
+    wire die0_oe, die1_oe;
+
+    reg [31:0] shadow [0:4095];
+    integer cycles;
+    integer reads = 0;
+    integer hits = 0;
+    integer wait_cycles = 0;
+    integer i;
+    integer pass;
+
+    always #5 clk = ~clk;
+
+    psram_cache #(
+        .WAYS(WAYS)
+    ) dut (
+        .clk(clk),
+        .rst(rst),
+        .addr(addr),
+        .re(re),
+        .we(we),
+        .wdata(wdata),
+        .wstrb(wstrb),
+        .rdata(rdata),
+        .ready(ready),
+        .mem_start(mem_start),
+        .mem_write(mem_write),
+        .mem_addr(mem_addr),
+        .mem_wdata(mem_wdata),
+        .mem_wstrb(mem_wstrb),
+        .mem_busy(mem_busy),
+        .mem_rdata(mem_rdata),
+        .mem_rvalid(mem_rvalid)
+    );
+
+    psram #(
+        .INIT_CYCLES(16)
+    ) controller (
+        .clk(clk),
+        .rst(rst),
+        .start(mem_start),
+        .write(mem_write),
+        .addr(mem_addr),
+        .wdata(mem_wdata),
+        .wstrb(mem_wstrb),
+        .busy(mem_busy),
+        .rdata(mem_rdata),
+        .rvalid(mem_rvalid),
+        .psram_ck(psram_ck),
+        .psram_ck_n(psram_ck_n),
+        .psram_cs_n(psram_cs_n),
+        .psram_reset_n(psram_reset_n),
+        .psram_dq_out(psram_dq_out),
+        .psram_dq_oe(psram_dq_oe),
+        .psram_dq_in({die1_oe ? die1_dq : 8'hFF, die0_oe ? die0_dq : 8'hFF}),
+        .psram_rwds_out(psram_rwds_out),
+        .psram_rwds_oe(psram_rwds_oe)
+    );
+
+    psram_model die0(
+        .ck(psram_ck[0]),
+        .cs_n(psram_cs_n[0]),
+        .reset_n(psram_reset_n[0]),
+        .dq_in(psram_dq_oe ? psram_dq_out[7:0] : 8'hFF),
+        .dq_out(die0_dq),
+        .dq_oe(die0_oe),
+        .rwds_in(psram_rwds_oe && psram_rwds_out[0])
+    );
+
+    psram_model die1(
+        .ck(psram_ck[1]),
+        .cs_n(psram_cs_n[1]),
+        .reset_n(psram_reset_n[1]),
+        .dq_in(psram_dq_oe ? psram_dq_out[15:8] : 8'hFF),
+        .dq_out(die1_dq),
+        .dq_oe(die1_oe),
+        .rwds_in(psram_rwds_oe && psram_rwds_out[1])
+    );
+
+    // Hold a request until ready, counting the cycles it waited
+    task bus_wait;
+        begin
+            cycles = 0;
+            #1;
+            while (!ready) begin
+                cycles = cycles + 1;
+                if (cycles > 1000)
+                    $fatal(1, "PSRAM access to %0d did not finish", addr);
+                @(negedge clk);
+            end
+        end
+    endtask
+
+    task cpu_write;
+        input [20:0] word;
+        input [31:0] data;
+        input [3:0] strobes;
+        begin
+            @(negedge clk);
+            addr = word;
+            wdata = data;
+            wstrb = strobes;
+            we = 1;
+            bus_wait;
+            @(posedge clk);
+            #1;
+            we = 0;
+            wstrb = 0;
+            if (strobes[0]) shadow[word[11:0]][7:0] = data[7:0];
+            if (strobes[1]) shadow[word[11:0]][15:8] = data[15:8];
+            if (strobes[2]) shadow[word[11:0]][23:16] = data[23:16];
+            if (strobes[3]) shadow[word[11:0]][31:24] = data[31:24];
+        end
+    endtask
+
+    task cpu_read;
+        input [20:0] word;
+        begin
+            @(negedge clk);
+            addr = word;
+            re = 1;
+            bus_wait;
+            reads = reads + 1;
+            wait_cycles = wait_cycles + cycles;
+            if (cycles == 0)
+                hits = hits + 1;
+            if (rdata !== shadow[word[11:0]]) begin
+                $display("PSRAM read mismatch at %0d: got %08x expected %08x",
+                         word, rdata, shadow[word[11:0]]);
+                $fatal(1);
+            end
+            @(posedge clk);
+            #1;
+            re = 0;
+            // The bus samples loads once more in the next cycle
+            if (rdata !== shadow[word[11:0]])
+                $fatal(1, "PSRAM read data at %0d did not hold", word);
+        end
+    endtask
+
+    initial begin
+        repeat (3) @(posedge clk);
+        rst = 0;
+
+        // Fill four lines with stores that miss, then patch single bytes
+        for (i = 0; i < 32; i = i + 1)
+            cpu_write(i, {i[15:0] ^ 16'hA5A5, ~i[15:0]}, 4'b1111);
+        cpu_write(3, 32'h11223344, 4'b0001);
+        cpu_write(3, 32'h55667788, 4'b1100);
+
+        // The first word of every line misses, the rest hit
+        for (i = 0; i < 32; i = i + 1)
+            cpu_read(i);
+
+        // Stores to a cached line update it and the PSRAM
+        cpu_write(9, 32'hCAFEF00D, 4'b1111);
+        cpu_write(10, 32'h0000BEEF, 4'b0011);
+        cpu_read(9);
+        cpu_read(10);
+
+        // Lines 512 words apart share a set: two fit in a 2-way cache, a
+        // third evicts the least recently used one
+        cpu_write(512, 32'h00000200, 4'b1111);
+        cpu_write(1024, 32'h00000400, 4'b1111);
+        for (pass = 0; pass < 4; pass = pass + 1) begin
+            cpu_read(0);
+            cpu_read(512);
+        end
+        cpu_read(1024);
+        cpu_read(0);
+        cpu_read(9);
+
+        // A loop over a small array hits once it is loaded
+        for (pass = 0; pass < 8; pass = pass + 1) begin
+            for (i = 0; i < 32; i = i + 1)
+                cpu_read(i);
+        end
+
+        // Latency counts the wait cycles a read adds to a block RAM access
+        $display("psram_cache_tb: WAYS=%0d, %0d reads, hit rate %0d.%01d%%, average latency %0d.%02d cycles",
+                 WAYS, reads, hits * 100 / reads, hits * 1000 / reads % 10,
+                 wait_cycles / reads, wait_cycles * 100 / reads % 100);
+        $display("psram_cache_tb: PASS");
+        $finish;
+    end
+endmodule
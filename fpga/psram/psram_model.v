@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Behavioural model of one HyperBus PSRAM die, for simulation only.
+// Takes the command-address on the first 6 CK edges and transfers data from
+// edge 6 + 4 x LATENCY on, high byte of each 16-bit word first, in linear
+// bursts: reads drive DQ on each edge, writes store DQ unless RWDS is high.
+// Register space accesses are ignored. The data lines are split into in, out
+// and output enable like psram.v, so no tristate nets are needed.
+module psram_model #(
+    parameter integer LATENCY = 6,
+    parameter integer ADDR_BITS = 21   // 16-bit words
+) (
+    input wire ck,
+    input wire cs_n,
+    input wire reset_n,
+    input wire [7:0] dq_in,
+    output reg [7:0] dq_out,
+    output reg dq_oe,
+    input wire rwds_in
+);
+    localparam integer DATA_EDGE = 6 + 4 * LATENCY;
+
+    reg [15:0] mem [0:(1 << ADDR_BITS) - 1];
+
+    reg [7:0] edge_index;
+    reg [47:0] ca;
+    reg [ADDR_BITS - 1:0] word_addr;
+
+    wire is_read = ca[47];
+    wire is_memory = !ca[46];
+
+    initial begin
+        edge_index = 0;
+        dq_out = 8'h00;
+        dq_oe = 0;
+    end
+
+    always @(posedge ck or negedge ck or posedge cs_n) begin
+        if (cs_n || !reset_n) begin
+            edge_index <= 0;
+            dq_oe <= 0;
+        end else begin
+            if (edge_index != 8'hFF)
+                edge_index <= edge_index + 1;
+
+            if (edge_index < 6) begin
+                ca <= {ca[39:0], dq_in};
+                if (edge_index == 5)
+                    word_addr <= {ca[ADDR_BITS + 4:8], dq_in[2:0]};
+            end else if (edge_index >= DATA_EDGE && is_memory) begin
+                if (is_read) begin
+                    dq_oe <= 1;
+                    dq_out <= edge_index[0] ? mem[word_addr][7:0] : mem[word_addr][15:8];
+                end else if (!edge_index[0]) begin
+                    if (!rwds_in)
+                        mem[word_addr][15:8] <= dq_in;
+                end else if (!rwds_in) begin
+                    mem[word_addr][7:0] <= dq_in;
+                end
+                if (edge_index[0])
+                    word_addr <= word_addr + 1;
+            end
+        end
+    end
+endmodule
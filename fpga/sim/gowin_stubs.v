@@ -0,0 +1,116 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ *
+ * Behavioural stand-ins for the Gowin primitives used by taro/hdmi.v, for
+ * simulation only. The PLL forwards its input clock, so the simulated pixel
+ * clock runs at clk / 5 instead of 25.2 MHz. The serializers only forward
+ * bit 0 of each TMDS word; the text-mode pipeline is checked before them.
+ */
+
+module rPLL #(
+    parameter FCLKIN = "100.0",
+    parameter IDIV_SEL = 0,
+    parameter FBDIV_SEL = 0,
+    parameter ODIV_SEL = 8,
+    parameter DYN_IDIV_SEL = "false",
+    parameter DYN_FBDIV_SEL = "false",
+    parameter DYN_ODIV_SEL = "false",
+    parameter CLKFB_SEL = "internal",
+    parameter CLKOUT_BYPASS = "false",
+    parameter CLKOUTP_BYPASS = "false",
+    parameter CLKOUTD_BYPASS = "false",
+    parameter DEVICE = "GW1NR-9C"
+) (
+    input  wire       CLKIN,
+    output wire       CLKOUT,
+    output reg        LOCK = 1'b0,
+    output wire       CLKOUTP,
+    output wire       CLKOUTD,
+    output wire       CLKOUTD3,
+    input  wire       RESET,
+    input  wire       RESET_P,
+    input  wire       CLKFB,
+    input  wire [5:0] FBDSEL,
+    input  wire [5:0] IDSEL,
+    input  wire [5:0] ODSEL,
+    input  wire [3:0] PSDA,
+    input  wire [3:0] DUTYDA,
+    input  wire [3:0] FDLY
+);
+    // Lock after a few input cycles so the pixel-domain reset sequence runs.
+    reg [3:0] lock_count = 4'd0;
+    always @(posedge CLKIN) begin
+        if (RESET || RESET_P) begin
+            lock_count <= 0;
+            LOCK <= 0;
+        end else if (lock_count != 4'hF) begin
+            lock_count <= lock_count + 1'b1;
+        end else begin
+            LOCK <= 1;
+        end
+    end
+
+    assign CLKOUT = CLKIN;
+    assign CLKOUTP = CLKIN;
+    assign CLKOUTD = CLKIN;
+    assign CLKOUTD3 = CLKIN;
+endmodule
+
+module CLKDIV #(
+    parameter DIV_MODE = "2",
+    parameter GSREN = "false"
+) (
+    input  wire HCLKIN,
+    input  wire RESETN,
+    input  wire CALIB,
+    output reg  CLKOUT = 1'b0
+);
+    localparam integer DIVISOR = DIV_MODE == "8"   ? 8 :
+                                 DIV_MODE == "5"   ? 5 :
+                                 DIV_MODE == "4"   ? 4 :
+                                 DIV_MODE == "3.5" ? 4 : 2;
+
+    reg [2:0] count = 3'd0;
+    always @(posedge HCLKIN or negedge RESETN) begin
+        if (!RESETN) begin
+            count <= 0;
+            CLKOUT <= 0;
+        end else if (count == DIVISOR - 1) begin
+            count <= 0;
+            CLKOUT <= 0;
+        end else begin
+            count <= count + 1'b1;
+            if (count == DIVISOR / 2 - 1)
+                CLKOUT <= 1;
+        end
+    end
+endmodule
+
+module OSER10 #(
+    parameter GSREN = "false",
+    parameter LSREN = "true"
+) (
+    output reg  Q = 1'b0,
+    input  wire D0, D1, D2, D3, D4, D5, D6, D7, D8, D9,
+    input  wire PCLK,
+    input  wire FCLK,
+    input  wire RESET
+);
+    always @(posedge PCLK) begin
+        if (RESET)
+            Q <= 0;
+        else
+            Q <= D0;
+    end
+endmodule
+
+module ELVDS_OBUF(
+    input  wire I,
+    output wire O,
+    output wire OB
+);
+    assign O = I;
+    assign OB = ~I;
+endmodule
@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Verilator harness for fpga/top.v
+// Clocks the full SoC with the $readmemh boot image (or another ROM image
+// given with --rom, such as a benchmark), drives the UART RX line
+// from a file or string, decodes the UART TX line, renders frame dumps from
+// the text RAM and origin register of text_mode.v, and can trace to FST.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "Vtop.h"
+#include "Vtop___024root.h"
+#include "sim_line.h"
+#include "taro.h"
+#include "verilated.h"
+#include "verilated_fst_c.h"
+
+#define FRAME_CYCLES (SIM_LINE_CLK_FREQ / 60)
+#define VIDEO_BASE 0x80000000u
+#define VIDEO_SIZE 0x00002580u
+#define VIDEO_REGS 0x80003000u
+#define VIDEO_REGS_SIZE 0x00000018u
+#define UART_RX_DATA 0x4000000Cu
+
+// Sizes of the rom and the UART RX FIFO memory as top.v declares them
+#define ROM_WORDS ((int)(sizeof(Vtop___024root::top__DOT__rom) / sizeof(Vtop___024root::top__DOT__rom[0])))
+#define UART_FIFO_DEPTH ((int)sizeof(Vtop___024root::top__DOT__uart_inst__DOT__rx_fifo__DOT__mem))
+
+static Taro taro;
+static SimLine line;
+
+// Signals of the text_mode.v instance in top.v
+#define TEXT_MODE(root, name) ((root)->top__DOT__taro_inst__DOT__hdmi_inst__DOT__text_mode_inst__DOT__##name)
+
+// Copy the text RAM and origin register of text_mode.v into the host renderer,
+// which then draws the screen the RTL scans out
+static void taro_sync(Vtop___024root* root) {
+    taro_write(&taro, TARO_ORIGIN_WORD, TEXT_MODE(root, origin), 0x1);
+    for (uint32_t word = 0; word < TARO_TEXT_WORDS; word++) {
+        uint32_t cells = TEXT_MODE(root, text_even)[word] | ((uint32_t)TEXT_MODE(root, text_odd)[word] << 16);
+        taro_write(&taro, word, cells, 0xF);
+    }
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --rom FILE         boot from the hex words in FILE instead of target/boot.mem\n" SIM_LINE_USAGE
+            "  --cycles N         stop after N clock cycles (default 100000000)\n"
+            "  --frame FILE       write the final Taro frame as a PPM image\n"
+            "  --video FILE       append a raw RGB24 640x480 frame every 1/60 s of simulated time\n"
+            "  --font FILE        Taro font (default fpga/taro/font.pf)\n"
+            "  --taro SOURCE      build frames from the text RAM (rtl, default) or from CPU writes\n"
+            "                     to Taro replayed on the host model (mirror)\n"
+            "  --trace FILE       write an FST waveform\n",
+            program);
+}
+
+int main(int argc, char* argv[]) {
+    const char* rom_path = NULL;
+    const char* frame_path = NULL;
+    const char* video_path = NULL;
+    const char* font_path = "fpga/taro/font.pf";
+    const char* trace_path = NULL;
+    int mirror = 0;
+    uint64_t max_cycles = 100000000;
+
+    sim_line_init(&line);
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return 1;
+        }
+        const char* value = argv[++i];
+        int handled = sim_line_option(&line, arg, value);
+        if (handled < 0)
+            return 1;
+        if (handled)
+            continue;
+        if (strcmp(arg, "--rom") == 0) {
+            rom_path = value;
+        } else if (strcmp(arg, "--cycles") == 0) {
+            max_cycles = strtoull(value, NULL, 10);
+        } else if (strcmp(arg, "--frame") == 0) {
+            frame_path = value;
+        } else if (strcmp(arg, "--video") == 0) {
+            video_path = value;
+        } else if (strcmp(arg, "--font") == 0) {
+            font_path = value;
+        } else if (strcmp(arg, "--trace") == 0) {
+            trace_path = value;
+        } else if (strcmp(arg, "--taro") == 0 && (strcmp(value, "rtl") == 0 || strcmp(value, "mirror") == 0)) {
+            mirror = strcmp(value, "mirror") == 0;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    taro_init(&taro, NULL);
+    if (taro_load_font(&taro, font_path) != 0) {
+        fprintf(stderr, "Cannot load 2048-byte font: %s\n", font_path);
+        return 1;
+    }
+
+    FILE* video_file = NULL;
+    if (video_path && !(video_file = fopen(video_path, "wb"))) {
+        fprintf(stderr, "Cannot open video file: %s\n", video_path);
+        return 1;
+    }
+
+    VerilatedContext* context = new VerilatedContext;
+    if (trace_path)
+        context->traceEverOn(true);
+    Vtop* top = new Vtop(context);
+    VerilatedFstC* trace = NULL;
+    if (trace_path) {
+        trace = new VerilatedFstC;
+        top->trace(trace, 99);
+        trace->open(trace_path);
+    }
+
+    // The bit time follows firmware writes to the UART divisor register
+    uint32_t baud_ticks = SIM_LINE_BAUD_TICKS;
+
+    // UART RX driver: bytes are sent back to back with a one-bit gap while
+    // the RX FIFO has room and --rx-wait does not hold them, counting reads
+    // of the RX data register.
+    int rx_index = 0;
+    int rx_bit = -1;  // -1 idle, 0 start bit, 1-8 data bits, 9 stop bit
+    uint32_t rx_ticks = 0;
+    int rx_reads = 0;
+
+    // UART TX decoder samples each bit in the middle of its period
+    int tx_bit = -1;
+    uint32_t tx_ticks = 0;
+    uint8_t tx_shift = 0;
+    int matched = 0;
+
+    top->btn1 = 1;
+    top->uart_rx = 1;
+    top->clk = 0;
+    top->eval();
+
+    // The initial block has loaded the default image by now, replace it
+    if (rom_path) {
+        static uint32_t words[ROM_WORDS];
+        if (sim_line_load_hex(rom_path, words, ROM_WORDS) != 0) {
+            fprintf(stderr, "Cannot open ROM file: %s\n", rom_path);
+            return 1;
+        }
+        for (int i = 0; i < ROM_WORDS; i++)
+            top->rootp->top__DOT__rom[i] = words[i];
+    }
+
+    uint64_t cycle;
+    for (cycle = 0; cycle < max_cycles && !matched; cycle++) {
+        // Sample the bus request that the coming rising edge will commit.
+        Vtop___024root* root = top->rootp;
+        uint32_t addr = root->top__DOT__cpu_mem_addr;
+        if (mirror && root->top__DOT__cpu_mem_we &&
+            ((addr >= VIDEO_BASE && addr < VIDEO_BASE + VIDEO_SIZE) ||
+             (addr >= VIDEO_REGS && addr < VIDEO_REGS + VIDEO_REGS_SIZE)))
+            taro_write(&taro, (addr - VIDEO_BASE) >> 2, root->top__DOT__cpu_mem_wdata, root->top__DOT__cpu_mem_wstrb);
+        if (root->top__DOT__cpu_mem_re && addr == UART_RX_DATA && rx_reads < rx_index)
+            rx_reads++;
+        // Follow the divisor register itself, so ignored writes are ignored here too
+        baud_ticks = root->top__DOT__uart_inst__DOT__divisor;
+
+        // Drive the RX line
+        if (rx_bit < 0) {
+            top->uart_rx = 1;
+            if (rx_index < sim_line_rx_released(&line) && rx_index - rx_reads < UART_FIFO_DEPTH) {
+                if (rx_ticks < baud_ticks) {
+                    rx_ticks++;
+                } else {
+                    rx_bit = 0;
+                    rx_ticks = 0;
+                }
+            }
+        }
+        if (rx_bit >= 0) {
+            uint8_t byte = line.rx_bytes[rx_index];
+            top->uart_rx = rx_bit == 0 ? 0 : rx_bit == 9 ? 1 : (byte >> (rx_bit - 1)) & 1;
+            if (++rx_ticks == baud_ticks) {
+                rx_ticks = 0;
+                if (++rx_bit == 10) {
+                    rx_bit = -1;
+                    rx_index++;
+                }
+            }
+        }
+
+        top->clk = 1;
+        top->eval();
+        if (trace)
+            trace->dump(context->time());
+        context->timeInc(1);
+        top->clk = 0;
+        top->eval();
+        if (trace)
+            trace->dump(context->time());
+        context->timeInc(1);
+
+        // Decode the TX line
+        if (tx_bit < 0) {
+            if (!top->uart_tx) {
+                tx_bit = 0;
+                tx_ticks = 0;
+            }
+        } else if (++tx_ticks == (tx_bit == 0 ? baud_ticks / 2 : baud_ticks)) {
+            tx_ticks = 0;
+            if (tx_bit == 0 && top->uart_tx) {
+                tx_bit = -1;  // glitch, not a start bit
+            } else if (tx_bit >= 1 && tx_bit <= 8) {
+                tx_shift = (uint8_t)((tx_shift >> 1) | (top->uart_tx << 7));
+                tx_bit++;
+            } else if (tx_bit == 9) {
+                matched = sim_line_tx(&line, tx_shift);
+                tx_bit = -1;
+            } else {
+                tx_bit++;
+            }
+        }
+
+        if (video_file && cycle % FRAME_CYCLES == FRAME_CYCLES - 1) {
+            if (!mirror)
+                taro_sync(top->rootp);
+            taro_render(&taro);
+            taro_write_rgb(&taro, video_file);
+        }
+    }
+
+    int unmatched = sim_line_finish(&line);
+    if (frame_path && !mirror)
+        taro_sync(top->rootp);
+    if (video_file)
+        fclose(video_file);
+    if (trace) {
+        trace->close();
+        delete trace;
+    }
+    top->final();
+    delete top;
+    delete context;
+
+    if (frame_path) {
+        taro_render(&taro);
+        FILE* frame_file = fopen(frame_path, "wb");
+        if (!frame_file || taro_write_ppm(&taro, frame_file) != 0) {
+            fprintf(stderr, "Cannot write frame file: %s\n", frame_path);
+            return 1;
+        }
+        fclose(frame_file);
+    }
+
+    fprintf(stderr, "top_sim: %llu cycles\n", (unsigned long long)cycle);
+    if (unmatched) {
+        fprintf(stderr, "top_sim: UART output did not reach the expected text\n");
+        return 1;
+    }
+    return 0;
+}
@@ -20,6 +20,7 @@
 module hdmi(
     input  wire clk,
     input  wire video_we,
+    input  wire video_re,
     input  wire [11:0] video_addr,
     input  wire [31:0] video_wdata,
     input  wire [3:0] video_wstrb,
@@ -120,6 +121,7 @@ wire hsync, vsync, de;
 text_mode text_mode_inst(
     .cpu_clk(clk),
     .cpu_we(video_we),
+    .cpu_re(video_re),
     .cpu_addr(video_addr),
     .cpu_wdata(video_wdata),
     .cpu_wstrb(video_wstrb),
@@ -12,6 +12,7 @@
 module taro(
     input  wire        clk,
     input  wire        video_we,
+    input  wire        video_re,
     input  wire [11:0] video_addr,
     input  wire [31:0] video_wdata,
     input  wire [3:0]  video_wstrb,
@@ -25,6 +26,7 @@ module taro(
 hdmi hdmi_inst(
     .clk(clk),
     .video_we(video_we),
+    .video_re(video_re),
     .video_addr(video_addr),
     .video_wdata(video_wdata),
     .video_wstrb(video_wstrb),
@@ -4,15 +4,31 @@
  * SPDX-License-Identifier: MIT
  *
  * 80x60 text-mode renderer for a 640x480 active video area.
+ *
+ * CPU word map:
+ *   0-2399 - text cells, two per word
+ *   0xC00  - origin: the text row shown at the top of the screen; display row
+ *            r shows text row (r + origin) mod 60
+ *   0xC01  - blit source word
+ *   0xC02  - blit destination word
+ *   0xC03  - blit length in words
+ *   0xC04  - blit fill value (two cells)
+ *   0xC05  - blit control: write 1 to fill or 2 to copy; bit 0 reads busy
+ *
+ * The blitter runs on the CPU-side memory port in the cycles the CPU leaves
+ * free: fills take one cycle per word and copies two. Copies with the
+ * destination above the source run backwards, so overlapping moves are safe.
+ * Blit registers are ignored while busy.
  */
 
 module text_mode(
     input  wire        cpu_clk,
     input  wire        cpu_we,
+    input  wire        cpu_re,
     input  wire [11:0] cpu_addr,
     input  wire [31:0] cpu_wdata,
     input  wire [3:0]  cpu_wstrb,
-    output reg  [31:0] cpu_rdata,
+    output wire [31:0] cpu_rdata,
 
     input  wire       px_clk,
     input  wire       px_reset,
@@ -30,6 +46,13 @@ module text_mode(
 );
 
 localparam TEXT_WORDS = 2400;
+localparam TEXT_ROWS = 60;
+localparam [11:0] ORIGIN_ADDR = 12'hC00;
+localparam [11:0] BLIT_SRC_ADDR = 12'hC01;
+localparam [11:0] BLIT_DST_ADDR = 12'hC02;
+localparam [11:0] BLIT_LEN_ADDR = 12'hC03;
+localparam [11:0] BLIT_FILL_ADDR = 12'hC04;
+localparam [11:0] BLIT_CTRL_ADDR = 12'hC05;
 
 // Each CPU word contains two adjacent 16-bit character cells. Splitting even
 // and odd cells into separate memories permits a 32-bit CPU access alongside
@@ -38,21 +61,135 @@ localparam TEXT_WORDS = 2400;
 (* syn_ramstyle = "block_ram" *) reg [15:0] text_odd  [0:TEXT_WORDS - 1];
 
 wire cpu_addr_valid = cpu_addr < TEXT_WORDS;
-wire [11:0] safe_cpu_addr = cpu_addr_valid ? cpu_addr : 12'b0;
+wire cpu_text = (cpu_we || cpu_re) && cpu_addr_valid;
+
+// Origin register; writes of 60 or more are ignored
+reg [5:0] origin = 6'd0;
+
+// === Blitter ===
+reg [11:0] blit_src = 12'd0;
+reg [11:0] blit_dst = 12'd0;
+reg [11:0] blit_len = 12'd0;
+reg [31:0] blit_fill = 32'b0;
+reg blit_busy = 0;
+reg blit_copy = 0;
+reg blit_backward = 0;
+reg blit_write_phase = 0;  // copy: the source word is in port_*_q
+reg [11:0] blit_src_addr = 12'd0;
+reg [11:0] blit_dst_addr = 12'd0;
+reg [11:0] blit_count = 12'd0;
+
+wire blit_start = cpu_we && cpu_addr == BLIT_CTRL_ADDR && !blit_busy &&
+                  (cpu_wdata[1:0] == 2'd1 || cpu_wdata[1:0] == 2'd2);
+wire blit_param_we = cpu_we && !blit_busy;
+wire blit_reads = blit_copy && !blit_write_phase;
+wire [11:0] blit_addr = blit_reads ? blit_src_addr : blit_dst_addr;
+
+// The CPU owns the memory port during its own text accesses; the blitter
+// uses the remaining cycles
+wire blit_cycle = blit_busy && !cpu_text;
+wire [11:0] port_addr = cpu_text ? cpu_addr : blit_addr;
+wire port_valid = port_addr < TEXT_WORDS;
+wire [11:0] safe_port_addr = port_valid ? port_addr : 12'b0;
+wire port_we = port_valid && (cpu_text ? cpu_we : blit_cycle && !blit_reads);
+wire [3:0] port_wstrb = cpu_text ? cpu_wstrb : 4'b1111;
+reg [15:0] port_even_q;
+reg [15:0] port_odd_q;
+wire [31:0] port_wdata = cpu_text ? cpu_wdata :
+                         blit_copy ? {port_odd_q, port_even_q} : blit_fill;
 
 always @(posedge cpu_clk) begin
-    cpu_rdata <= cpu_addr_valid ?
-        {text_odd[safe_cpu_addr], text_even[safe_cpu_addr]} : 32'b0;
-    if (cpu_we && cpu_addr_valid) begin
-        if (cpu_wstrb[0]) text_even[safe_cpu_addr][7:0]  <= cpu_wdata[7:0];
-        if (cpu_wstrb[1]) text_even[safe_cpu_addr][15:8] <= cpu_wdata[15:8];
-        if (cpu_wstrb[2]) text_odd[safe_cpu_addr][7:0]   <= cpu_wdata[23:16];
-        if (cpu_wstrb[3]) text_odd[safe_cpu_addr][15:8]  <= cpu_wdata[31:24];
+    port_even_q <= text_even[safe_port_addr];
+    port_odd_q  <= text_odd[safe_port_addr];
+    if (port_we) begin
+        if (port_wstrb[0]) text_even[safe_port_addr][7:0]  <= port_wdata[7:0];
+        if (port_wstrb[1]) text_even[safe_port_addr][15:8] <= port_wdata[15:8];
+        if (port_wstrb[2]) text_odd[safe_port_addr][7:0]   <= port_wdata[23:16];
+        if (port_wstrb[3]) text_odd[safe_port_addr][15:8]  <= port_wdata[31:24];
     end
 end
 
+wire [11:0] blit_step = blit_backward ? 12'hFFF : 12'd1;
+
+always @(posedge cpu_clk) begin
+    if (cpu_we && cpu_addr == ORIGIN_ADDR && cpu_wstrb[0] && cpu_wdata[7:0] < TEXT_ROWS)
+        origin <= cpu_wdata[5:0];
+    if (blit_param_we && cpu_addr == BLIT_SRC_ADDR)
+        blit_src <= cpu_wdata[11:0];
+    if (blit_param_we && cpu_addr == BLIT_DST_ADDR)
+        blit_dst <= cpu_wdata[11:0];
+    if (blit_param_we && cpu_addr == BLIT_LEN_ADDR)
+        blit_len <= cpu_wdata[11:0];
+    if (blit_param_we && cpu_addr == BLIT_FILL_ADDR)
+        blit_fill <= cpu_wdata;
+
+    if (blit_start) begin
+        blit_copy <= cpu_wdata[1];
+        blit_backward <= cpu_wdata[1] && blit_dst > blit_src;
+        blit_write_phase <= 0;
+        if (cpu_wdata[1] && blit_dst > blit_src) begin
+            blit_src_addr <= blit_src + blit_len - 12'd1;
+            blit_dst_addr <= blit_dst + blit_len - 12'd1;
+        end else begin
+            blit_src_addr <= blit_src;
+            blit_dst_addr <= blit_dst;
+        end
+        blit_count <= blit_len;
+        blit_busy <= blit_len != 0;
+    end else if (blit_busy) begin
+        if (!blit_cycle) begin
+            // A CPU access replaced the source word read by the blitter
+            blit_write_phase <= 0;
+        end else if (blit_reads) begin
+            blit_write_phase <= 1;
+        end else begin
+            blit_write_phase <= 0;
+            blit_src_addr <= blit_src_addr + blit_step;
+            blit_dst_addr <= blit_dst_addr + blit_step;
+            blit_count <= blit_count - 12'd1;
+            if (blit_count == 12'd1)
+                blit_busy <= 0;
+        end
+    end
+end
+
+// Reads of text cells return the port data; registers and unmapped words
+// are selected here
+reg cpu_read_text;
+reg [31:0] reg_rdata;
+always @(posedge cpu_clk) begin
+    cpu_read_text <= cpu_text;
+    case (cpu_addr)
+        ORIGIN_ADDR: reg_rdata <= {26'b0, origin};
+        BLIT_SRC_ADDR: reg_rdata <= {20'b0, blit_src};
+        BLIT_DST_ADDR: reg_rdata <= {20'b0, blit_dst};
+        BLIT_LEN_ADDR: reg_rdata <= {20'b0, blit_len};
+        BLIT_FILL_ADDR: reg_rdata <= blit_fill;
+        BLIT_CTRL_ADDR: reg_rdata <= {31'b0, blit_busy};
+        default: reg_rdata <= 32'b0;
+    endcase
+end
+assign cpu_rdata = cpu_read_text ? {port_odd_q, port_even_q} : reg_rdata;
+
+// The origin crosses into the pixel clock domain through two registers and
+// is taken over during vertical blanking, once it has been stable for a
+// cycle, so a frame never shows a half-applied scroll.
+reg [5:0] origin_meta;
+reg [5:0] origin_sync;
+reg [5:0] px_origin;
+always @(posedge px_clk) begin
+    origin_meta <= origin;
+    origin_sync <= origin_meta;
+    if (px_reset)
+        px_origin <= 6'd0;
+    else if (vcnt[9:3] >= TEXT_ROWS && origin_sync == origin_meta)
+        px_origin <= origin_sync;
+end
+
 wire [6:0] text_col = hcnt[9:3];
-wire [6:0] text_row = vcnt[9:3];
+wire [6:0] screen_row = vcnt[9:3];
+wire [6:0] origin_row = screen_row + {1'b0, px_origin};
+wire [6:0] text_row = origin_row >= TEXT_ROWS ? origin_row - TEXT_ROWS : origin_row;
 wire [12:0] extended_text_row = {6'b0, text_row};
 wire [12:0] extended_text_col = {6'b0, text_col};
 wire [12:0] active_cell_addr = (extended_text_row << 6) +
@@ -9,6 +9,7 @@
 module text_mode_tb;
     reg cpu_clk = 0;
     reg cpu_we = 0;
+    reg cpu_re = 0;
     reg [11:0] cpu_addr = 0;
     reg [31:0] cpu_wdata = 0;
     reg [3:0] cpu_wstrb = 0;
@@ -26,12 +27,25 @@ module text_mode_tb;
 
     integer color_index;
 
+    // Golden vectors from tools/taro_vectors.c: per screen the 2400 text
+    // words, then for every cell the palette indices of the 8 pixels on the
+    // scanline checked in its text row (pixel x in bits 4x+3:4x)
+    localparam TEXT_SCREENS = 14;
+    localparam SCREEN_WORDS = 2400;
+    localparam SCREEN_CELLS = 4800;
+    localparam SCREEN_VECTORS = SCREEN_WORDS + SCREEN_CELLS;
+    reg [31:0] vectors [0:TEXT_SCREENS * SCREEN_VECTORS - 1];
+    integer screen;
+    integer word;
+    integer row;
+
     always #5 cpu_clk = ~cpu_clk;
     always #7 px_clk = ~px_clk;
 
     text_mode dut(
         .cpu_clk(cpu_clk),
         .cpu_we(cpu_we),
+        .cpu_re(cpu_re),
         .cpu_addr(cpu_addr),
         .cpu_wdata(cpu_wdata),
         .cpu_wstrb(cpu_wstrb),
@@ -98,8 +112,10 @@ module text_mode_tb;
         begin
             @(negedge cpu_clk);
             cpu_addr = addr;
+            cpu_re = 1;
             @(posedge cpu_clk);
             #1;
+            cpu_re = 0;
             if (cpu_rdata !== expected) begin
                 $display("CPU read mismatch at %0d: got %08x expected %08x",
                          addr, cpu_rdata, expected);
@@ -108,6 +124,23 @@ module text_mode_tb;
         end
     endtask
 
+    task blit_wait;
+        integer cycles;
+        begin
+            cycles = 0;
+            cpu_addr = 12'hC05;
+            @(posedge cpu_clk);
+            #1;
+            while (cpu_rdata[0] !== 0) begin
+                cycles = cycles + 1;
+                if (cycles > 10000)
+                    $fatal(1, "Blit did not finish");
+                @(posedge cpu_clk);
+                #1;
+            end
+        end
+    endtask
+
     task pixel_expect;
         input [9:0] x;
         input [9:0] y;
@@ -128,6 +161,36 @@ module text_mode_tb;
         end
     endtask
 
+    // Stream one scanline through the pixel pipeline, a pixel per clock, and
+    // check each pixel three clocks after it went in
+    task scan_line;
+        input [6:0] text_row;
+        input [2:0] glyph_y;
+        input [31:0] first_span;
+        integer pixel;
+        reg [23:0] expected;
+        begin
+            for (pixel = 0; pixel < 642; pixel = pixel + 1) begin
+                @(negedge px_clk);
+                hcnt = pixel < 640 ? pixel : 0;
+                vcnt = {text_row, glyph_y};
+                de = pixel < 640;
+                hsync = 1;
+                vsync = 1;
+                @(posedge px_clk);
+                #1;
+                if (pixel >= 2) begin
+                    expected = palette(vectors[first_span + (pixel - 2) / 8][4 * ((pixel - 2) % 8) +: 4]);
+                    if ({px_r, px_g, px_b} !== expected || !de_out) begin
+                        $display("Pixel mismatch at (%0d,%0d) of screen %0d: got %06x expected %06x de=%b",
+                                 pixel - 2, vcnt, screen, {px_r, px_g, px_b}, expected, de_out);
+                        $fatal(1);
+                    end
+                end
+            end
+        end
+    endtask
+
     initial begin
         repeat (3) @(posedge px_clk);
         px_reset = 0;
@@ -175,6 +238,84 @@ module text_mode_tb;
         if (de_out !== 0 || hsync_out !== 0 || vsync_out !== 0)
             $fatal(1, "Video control pipeline mismatch");
 
+        // The origin register moves text row 59 to the top of the screen. It
+        // is taken over in vertical blanking; out-of-range values are ignored.
+        cpu_write(12'hC00, 59, 4'b1111);
+        cpu_write(12'hC00, 60, 4'b1111);
+        cpu_expect(12'hC00, 59);
+        vcnt = 480;
+        repeat (4) @(posedge px_clk);
+        pixel_expect(639, 7, 24'hFF5555);
+        pixel_expect(0, 8, 24'h0000AA);
+        cpu_write(12'hC00, 0, 4'b1111);
+        de = 0;
+        vcnt = 480;
+        repeat (4) @(posedge px_clk);
+        pixel_expect(0, 0, 24'h0000AA);
+        pixel_expect(639, 479, 24'hFF5555);
+
+        // A full-screen fill takes one cycle per word
+        cpu_write(12'hC02, 0, 4'b1111);
+        cpu_write(12'hC03, 2400, 4'b1111);
+        cpu_write(12'hC04, 32'h07200720, 4'b1111);
+        cpu_write(12'hC05, 1, 4'b1111);
+        cpu_expect(12'hC05, 1);
+        blit_wait;
+        cpu_expect(0, 32'h07200720);
+        cpu_expect(2399, 32'h07200720);
+        pixel_expect(639, 479, 24'h000000);
+
+        // CPU accesses take the port from a running blit without being lost
+        cpu_write(12'hC02, 40, 4'b1111);
+        cpu_write(12'hC03, 40, 4'b1111);
+        cpu_write(12'hC04, 32'h4CDB1F41, 4'b1111);
+        cpu_write(12'hC05, 1, 4'b1111);
+        cpu_write(100, 32'h0C410C42, 4'b1111);
+        cpu_expect(100, 32'h0C410C42);
+        cpu_write(12'hC03, 1, 4'b1111);
+        cpu_expect(12'hC03, 40);
+        blit_wait;
+        cpu_expect(39, 32'h07200720);
+        cpu_expect(40, 32'h4CDB1F41);
+        cpu_expect(79, 32'h4CDB1F41);
+        cpu_expect(80, 32'h07200720);
+
+        // Overlapping copy towards lower addresses runs forwards
+        cpu_write(12'hC01, 40, 4'b1111);
+        cpu_write(12'hC02, 0, 4'b1111);
+        cpu_write(12'hC03, 80, 4'b1111);
+        cpu_write(12'hC05, 2, 4'b1111);
+        blit_wait;
+        cpu_expect(0, 32'h4CDB1F41);
+        cpu_expect(39, 32'h4CDB1F41);
+        cpu_expect(59, 32'h07200720);
+        cpu_expect(60, 32'h0C410C42);
+        pixel_expect(2, 0, 24'hFFFFFF);
+
+        // Overlapping copy towards higher addresses runs backwards
+        cpu_write(200, 1, 4'b1111);
+        cpu_write(201, 2, 4'b1111);
+        cpu_write(202, 3, 4'b1111);
+        cpu_write(12'hC01, 200, 4'b1111);
+        cpu_write(12'hC02, 201, 4'b1111);
+        cpu_write(12'hC03, 3, 4'b1111);
+        cpu_write(12'hC05, 2, 4'b1111);
+        blit_wait;
+        cpu_expect(200, 1);
+        cpu_expect(201, 1);
+        cpu_expect(202, 2);
+        cpu_expect(203, 3);
+        cpu_expect(12'hC01, 200);
+
+        // Every character with every attribute, against the C model
+        $readmemh("target/text_mode_vectors.mem", vectors);
+        for (screen = 0; screen < TEXT_SCREENS; screen = screen + 1) begin
+            for (word = 0; word < SCREEN_WORDS; word = word + 1)
+                cpu_write(word, vectors[screen * SCREEN_VECTORS + word], 4'b1111);
+            for (row = 0; row < 60; row = row + 1)
+                scan_line(row, (row + screen) % 8, screen * SCREEN_VECTORS + SCREEN_WORDS + row * 80);
+        end
+
         $display("text_mode_tb: PASS");
         $finish;
     end
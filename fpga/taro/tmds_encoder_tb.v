@@ -19,6 +19,12 @@ module tmds_encoder_tb;
     integer index;
     reg [7:0] samples [0:9];
 
+    // Golden vectors from tools/taro_vectors.c: the count, then
+    // {de, ctrl[1:0], din[7:0], symbol[9:0]} for every disparity state and byte
+    localparam MAX_VECTORS = 65536;
+    reg [23:0] vectors [0:MAX_VECTORS];
+    integer vector_count;
+
     always #5 clk = ~clk;
 
     tmds_encoder dut (
@@ -89,13 +95,14 @@ module tmds_encoder_tb;
         end
     endtask
 
-    task apply_symbol;
+    // Drive one input symbol and check the output of the previous one, which
+    // appears a cycle later
+    task drive_symbol;
         input symbol_de;
         input [1:0] symbol_ctrl;
         input [7:0] symbol_data;
-        reg [9:0] expected_next;
+        input [9:0] expected_next;
         begin
-            reference_symbol(symbol_de, symbol_ctrl, symbol_data, expected_next);
             @(negedge clk);
             de = symbol_de;
             ctrl = symbol_ctrl;
@@ -108,6 +115,17 @@ module tmds_encoder_tb;
         end
     endtask
 
+    task apply_symbol;
+        input symbol_de;
+        input [1:0] symbol_ctrl;
+        input [7:0] symbol_data;
+        reg [9:0] expected_next;
+        begin
+            reference_symbol(symbol_de, symbol_ctrl, symbol_data, expected_next);
+            drive_symbol(symbol_de, symbol_ctrl, symbol_data, expected_next);
+        end
+    endtask
+
     initial begin
         samples[0] = 8'h00;
         samples[1] = 8'hFF;
@@ -138,7 +156,16 @@ module tmds_encoder_tb;
         apply_symbol(0, 2'b11, 0);
         apply_symbol(0, 2'b00, 0);
 
-        $display("tmds_encoder_tb: PASS");
+        // Every byte from every reachable disparity, against the C model
+        $readmemh("target/tmds_vectors.mem", vectors);
+        vector_count = vectors[0];
+        if (vector_count < 1 || vector_count > MAX_VECTORS)
+            $fatal(1, "Bad TMDS vector count %0d", vector_count);
+        for (index = 1; index <= vector_count; index = index + 1)
+            drive_symbol(vectors[index][20], vectors[index][19:18], vectors[index][17:10], vectors[index][9:0]);
+        apply_symbol(0, 2'b00, 0);
+
+        $display("tmds_encoder_tb: PASS (%0d vectors)", vector_count);
         $finish;
     end
 endmodule
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Machine timer: 64-bit mtime counting clock cycles and a 64-bit mtimecmp.
+// irq (mip.MTIP) is high while mtime >= mtimecmp; mtimecmp resets to all
+// ones so no interrupt is pending until the firmware programs it.
+module timer(
+    input wire clk,
+    input wire rst,
+    input wire [1:0] addr,
+    input wire [31:0] wdata,
+    input wire we,
+    output reg [31:0] rdata,
+    output wire irq
+);
+    reg [63:0] mtime;
+    reg [63:0] mtimecmp;
+
+    // Register map:
+    //   0 - mtime low word
+    //   1 - mtime high word
+    //   2 - mtimecmp low word
+    //   3 - mtimecmp high word
+
+    assign irq = mtime >= mtimecmp;
+
+    always @(*) begin
+        case (addr)
+            2'b00: rdata = mtime[31:0];
+            2'b01: rdata = mtime[63:32];
+            2'b10: rdata = mtimecmp[31:0];
+            2'b11: rdata = mtimecmp[63:32];
+        endcase
+    end
+
+    always @(posedge clk) begin
+        if (rst) begin
+            mtime <= 64'b0;
+            mtimecmp <= {64{1'b1}};
+        end else begin
+            mtime <= mtime + 1'b1;
+            if (we) begin
+                case (addr)
+                    2'b00: mtime[31:0] <= wdata;
+                    2'b01: mtime[63:32] <= wdata;
+                    2'b10: mtimecmp[31:0] <= wdata;
+                    2'b11: mtimecmp[63:32] <= wdata;
+                endcase
+            end
+        end
+    end
+endmodule
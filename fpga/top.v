@@ -4,18 +4,47 @@
  * SPDX-License-Identifier: MIT
  */
 
+`include "cpu_divider.v"
+`include "cpu_rvc.v"
+`include "cpu_csr.v"
 `include "cpu.v"
+`include "cpu_pipeline.v"
 `include "uart/uart_tx.v"
 `include "uart/uart_rx.v"
+`include "uart/uart_fifo.v"
 `include "uart/uart.v"
+`include "timer/timer.v"
 `include "taro/taro.v"
+`include "psram/psram.v"
+`include "psram/psram_cache.v"
 
-module top(
+// The PSRAM is only built into the Verilator model for now. psram.v has not
+// been brought up on the GW1NR-9 dies, and the board constraints do not
+// place its ports, so synthesis leaves it out unless PSRAM is defined.
+`ifdef VERILATOR
+`define PSRAM
+`endif
+
+module top #(
+    // 0: multi-cycle cpu.v, 1: five-stage cpu_pipeline.v
+    parameter PIPELINED_CPU = 0
+) (
     input clk,
     output [5:0] led,
     input btn1,
     input uart_rx,
     output uart_tx,
+`ifdef PSRAM
+`ifndef VERILATOR
+    // Embedded PSRAM dies of the GW1NR-9
+    output [1:0] O_psram_ck,
+    output [1:0] O_psram_ck_n,
+    output [1:0] O_psram_cs_n,
+    output [1:0] O_psram_reset_n,
+    inout [15:0] IO_psram_dq,
+    inout [1:0] IO_psram_rwds,
+`endif
+`endif
     output tmds_clk_p,
     output tmds_clk_n,
     output [2:0] tmds_d_p,
@@ -42,17 +71,10 @@ reg [31:0] cpu_mem_rdata;
 wire cpu_mem_we;
 wire cpu_mem_re;
 wire [3:0] cpu_mem_wstrb;
-
-cpu cpu_inst(
-    .clk(clk),
-    .rst(rst),
-    .mem_addr(cpu_mem_addr),
-    .mem_wdata(cpu_mem_wdata),
-    .mem_rdata(cpu_mem_rdata),
-    .mem_we(cpu_mem_we),
-    .mem_re(cpu_mem_re),
-    .mem_wstrb(cpu_mem_wstrb)
-);
+wire timer_irq;
+wire uart_irq;
+wire cpu_mem_ready;
+wire [4:0] cpu_bus_region;  // for the performance counters: PSRAM, ROM, RAM, Taro, UART
 
 // === ROM (4KB, word-addressed, read-only) ===
 reg [31:0] rom [0:1023];
@@ -63,14 +85,17 @@ end
 wire rom_sel = (cpu_mem_addr[31:28] == 4'h0);
 wire [31:0] rom_rdata = rom[cpu_mem_addr[11:2]];
 
-// === RAM (4KB, byte-addressable via write strobes) ===
-(* syn_ramstyle = "block_ram" *) reg [7:0] ram0 [0:1023]; // byte 0
-(* syn_ramstyle = "block_ram" *) reg [7:0] ram1 [0:1023]; // byte 1
-(* syn_ramstyle = "block_ram" *) reg [7:0] ram2 [0:1023]; // byte 2
-(* syn_ramstyle = "block_ram" *) reg [7:0] ram3 [0:1023]; // byte 3
+// === RAM (16KB, byte-addressable via write strobes) ===
+// Holds the firmware's data and stack and images received by the UART
+// loader, so both cores can also fetch instructions from it.
+(* syn_ramstyle = "block_ram" *) reg [7:0] ram0 [0:4095]; // byte 0
+(* syn_ramstyle = "block_ram" *) reg [7:0] ram1 [0:4095]; // byte 1
+(* syn_ramstyle = "block_ram" *) reg [7:0] ram2 [0:4095]; // byte 2
+(* syn_ramstyle = "block_ram" *) reg [7:0] ram3 [0:4095]; // byte 3
 
 wire ram_sel = (cpu_mem_addr[31:28] == 4'h2);
-wire [9:0] ram_word_addr = cpu_mem_addr[11:2];
+wire [11:0] ram_word_addr = cpu_mem_addr[13:2];
+
 wire [31:0] ram_rdata = {ram3[ram_word_addr], ram2[ram_word_addr],
                          ram1[ram_word_addr], ram0[ram_word_addr]};
 
@@ -83,23 +108,75 @@ always @(posedge clk) begin
     end
 end
 
+// === CPU Core ===
+// The multi-cycle core fetches over the shared memory bus. The pipelined
+// core has its own synchronous instruction port into second read ports of
+// the ROM and RAM, so it cannot run code from the PSRAM.
+generate
+    if (PIPELINED_CPU) begin : core
+        wire [31:0] imem_addr;
+        reg [31:0] imem_rdata;
+        always @(posedge clk) begin
+            if (imem_addr[31:28] == 4'h2)
+                imem_rdata <= {ram3[imem_addr[13:2]], ram2[imem_addr[13:2]],
+                               ram1[imem_addr[13:2]], ram0[imem_addr[13:2]]};
+            else
+                imem_rdata <= rom[imem_addr[11:2]];
+        end
+
+        cpu_pipeline cpu_inst(
+            .clk(clk),
+            .rst(rst),
+            .imem_addr(imem_addr),
+            .imem_rdata(imem_rdata),
+            .mem_addr(cpu_mem_addr),
+            .mem_wdata(cpu_mem_wdata),
+            .mem_rdata(cpu_mem_rdata),
+            .mem_ready(cpu_mem_ready),
+            .mem_we(cpu_mem_we),
+            .mem_re(cpu_mem_re),
+            .mem_wstrb(cpu_mem_wstrb),
+            .timer_irq(timer_irq),
+            .external_irq(uart_irq),
+            .bus_region(cpu_bus_region)
+        );
+    end else begin : core
+        cpu cpu_inst(
+            .clk(clk),
+            .rst(rst),
+            .mem_addr(cpu_mem_addr),
+            .mem_wdata(cpu_mem_wdata),
+            .mem_rdata(cpu_mem_rdata),
+            .mem_ready(cpu_mem_ready),
+            .mem_we(cpu_mem_we),
+            .mem_re(cpu_mem_re),
+            .mem_wstrb(cpu_mem_wstrb),
+            .timer_irq(timer_irq),
+            .external_irq(uart_irq),
+            .bus_region(cpu_bus_region)
+        );
+    end
+endgenerate
+
 // === UART Device ===
 wire uart_sel = (cpu_mem_addr[31:28] == 4'h4);
 wire [31:0] uart_rdata;
 
 uart #(
     .CLK_FREQ(CLK_FREQ),
-    .BAUD_RATE(115200)
+    .BAUD_RATE(115200),
+    .FIFO_DEPTH(256)
 ) uart_inst (
     .clk(clk),
     .rst(rst),
-    .addr(cpu_mem_addr[3:2]),
+    .addr(cpu_mem_addr[4:2]),
     .wdata(cpu_mem_wdata),
     .we(uart_sel && cpu_mem_we),
     .re(uart_sel && cpu_mem_re),
     .rdata(uart_rdata),
     .rx(uart_rx),
-    .tx(uart_tx)
+    .tx(uart_tx),
+    .irq(uart_irq)
 );
 
 // === LED Register ===
@@ -117,26 +194,153 @@ always @(posedge clk) begin
     end
 end
 
+// === Machine Timer ===
+wire timer_sel = (cpu_mem_addr[31:28] == 4'hA);
+wire [31:0] timer_rdata;
+
+timer timer_inst(
+    .clk(clk),
+    .rst(rst),
+    .addr(cpu_mem_addr[3:2]),
+    .wdata(cpu_mem_wdata),
+    .we(timer_sel && cpu_mem_we),
+    .rdata(timer_rdata),
+    .irq(timer_irq)
+);
+
 // === Taro Text Video Device ===
 localparam VIDEO_BASE = 32'h80000000;
 localparam VIDEO_SIZE = 32'h00002580;
-wire video_sel = (cpu_mem_addr >= VIDEO_BASE) &&
-                 (cpu_mem_addr < VIDEO_BASE + VIDEO_SIZE);
+localparam VIDEO_REGS = 32'h80003000;
+localparam VIDEO_REGS_SIZE = 32'h00000018;
+wire video_sel = ((cpu_mem_addr >= VIDEO_BASE) &&
+                  (cpu_mem_addr < VIDEO_BASE + VIDEO_SIZE)) ||
+                 ((cpu_mem_addr >= VIDEO_REGS) &&
+                  (cpu_mem_addr < VIDEO_REGS + VIDEO_REGS_SIZE));
 wire [11:0] video_word_addr = video_sel ? cpu_mem_addr[13:2] : 12'b0;
 wire [31:0] video_rdata;
 
+// === PSRAM (8MB main memory behind a cache) ===
+// Hits answer like the RAM; misses and stores that find the write buffer
+// full hold cpu_mem_ready low. Without the PSRAM the region reads as zero.
+wire psram_sel = (cpu_mem_addr[31:28] == 4'h1);
+wire [31:0] psram_rdata;
+wire psram_ready;
+
+`ifdef PSRAM
+
+wire psram_start, psram_write, psram_busy, psram_rvalid;
+wire [20:0] psram_addr;
+wire [31:0] psram_wdata, psram_line_rdata;
+wire [3:0] psram_wstrb;
+
+psram_cache psram_cache_inst(
+    .clk(clk),
+    .rst(rst),
+    .addr(cpu_mem_addr[22:2]),
+    .re(psram_sel && cpu_mem_re),
+    .we(psram_sel && cpu_mem_we),
+    .wdata(cpu_mem_wdata),
+    .wstrb(cpu_mem_wstrb),
+    .rdata(psram_rdata),
+    .ready(psram_ready),
+    .mem_start(psram_start),
+    .mem_write(psram_write),
+    .mem_addr(psram_addr),
+    .mem_wdata(psram_wdata),
+    .mem_wstrb(psram_wstrb),
+    .mem_busy(psram_busy),
+    .mem_rdata(psram_line_rdata),
+    .mem_rvalid(psram_rvalid)
+);
+
+wire [1:0] psram_ck, psram_ck_n, psram_cs_n, psram_reset_n;
+wire [15:0] psram_dq_out, psram_dq_in;
+wire psram_dq_oe;
+wire [1:0] psram_rwds_out;
+wire psram_rwds_oe;
+
+psram psram_inst(
+    .clk(clk),
+    .rst(rst),
+    .start(psram_start),
+    .write(psram_write),
+    .addr(psram_addr),
+    .wdata(psram_wdata),
+    .wstrb(psram_wstrb),
+    .busy(psram_busy),
+    .rdata(psram_line_rdata),
+    .rvalid(psram_rvalid),
+    .psram_ck(psram_ck),
+    .psram_ck_n(psram_ck_n),
+    .psram_cs_n(psram_cs_n),
+    .psram_reset_n(psram_reset_n),
+    .psram_dq_out(psram_dq_out),
+    .psram_dq_oe(psram_dq_oe),
+    .psram_dq_in(psram_dq_in),
+    .psram_rwds_out(psram_rwds_out),
+    .psram_rwds_oe(psram_rwds_oe)
+);
+
+`ifdef VERILATOR
+// No pads in simulation: the dies are modelled by psram_model.v
+wire [7:0] psram_die0_dq, psram_die1_dq;
+wire psram_die0_oe, psram_die1_oe;
+assign psram_dq_in = {psram_die1_oe ? psram_die1_dq : 8'hFF,
+                      psram_die0_oe ? psram_die0_dq : 8'hFF};
+
+psram_model psram_die0(
+    .ck(psram_ck[0]),
+    .cs_n(psram_cs_n[0]),
+    .reset_n(psram_reset_n[0]),
+    .dq_in(psram_dq_oe ? psram_dq_out[7:0] : 8'hFF),
+    .dq_out(psram_die0_dq),
+    .dq_oe(psram_die0_oe),
+    .rwds_in(psram_rwds_oe && psram_rwds_out[0])
+);
+
+psram_model psram_die1(
+    .ck(psram_ck[1]),
+    .cs_n(psram_cs_n[1]),
+    .reset_n(psram_reset_n[1]),
+    .dq_in(psram_dq_oe ? psram_dq_out[15:8] : 8'hFF),
+    .dq_out(psram_die1_dq),
+    .dq_oe(psram_die1_oe),
+    .rwds_in(psram_rwds_oe && psram_rwds_out[1])
+);
+`else
+assign O_psram_ck = psram_ck;
+assign O_psram_ck_n = psram_ck_n;
+assign O_psram_cs_n = psram_cs_n;
+assign O_psram_reset_n = psram_reset_n;
+assign IO_psram_dq = psram_dq_oe ? psram_dq_out : 16'bz;
+assign IO_psram_rwds = psram_rwds_oe ? psram_rwds_out : 2'bz;
+assign psram_dq_in = IO_psram_dq;
+`endif
+`else
+assign psram_rdata = 32'b0;
+assign psram_ready = 1'b1;
+`endif
+
 // === Address Decoder (read mux) ===
+assign cpu_bus_region = {psram_sel, rom_sel, ram_sel, video_sel, uart_sel};
+assign cpu_mem_ready = psram_sel ? psram_ready : 1'b1;
+
 always @(*) begin
     if (rom_sel)
         cpu_mem_rdata = rom_rdata;
     else if (ram_sel)
         cpu_mem_rdata = ram_rdata;
+    else if (psram_sel)
+        cpu_mem_rdata = psram_rdata;
     else if (uart_sel)
         cpu_mem_rdata = uart_rdata;
     else if (led_sel)
         cpu_mem_rdata = led_rdata;
     else if (video_sel)
         cpu_mem_rdata = video_rdata;
+    else if (timer_sel)
+        cpu_mem_rdata = timer_rdata;
     else
         cpu_mem_rdata = 32'h00000000;
 end
@@ -145,6 +349,7 @@ end
 taro taro_inst(
     .clk(clk),
     .video_we(video_sel && cpu_mem_we),
+    .video_re(video_sel && cpu_mem_re),
     .video_addr(video_word_addr),
     .video_wdata(cpu_mem_wdata),
     .video_wstrb(cpu_mem_wstrb),
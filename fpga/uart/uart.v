@@ -6,65 +6,133 @@
 
 module uart #(
     parameter integer CLK_FREQ = 27000000,
-    parameter integer BAUD_RATE = 115200
+    parameter integer BAUD_RATE = 115200,
+    parameter integer FIFO_DEPTH = 16 // per direction, power of two
 ) (
     input wire clk,
     input wire rst,
-    input wire [1:0] addr,
+    input wire [2:0] addr,
     input wire [31:0] wdata,
     input wire we,
     input wire re,
     output reg [31:0] rdata,
     input wire rx,
-    output wire tx
+    output wire tx,
+    output wire irq
 );
+    localparam integer FIFO_ADDR_WIDTH = $clog2(FIFO_DEPTH);
+    localparam integer RESET_DIVISOR = (CLK_FREQ + BAUD_RATE / 2) / BAUD_RATE;
+
+    // Register map:
+    //   0 - TX data (write-only, queued; dropped when the TX FIFO is full)
+    //   1 - TX status: bit 0 FIFO full, bit 1 busy (queued or sending),
+    //       bit 2 TX level at or below threshold
+    //   2 - RX status: bit 0 ready, bit 1 overrun, bit 2 framing error,
+    //       bit 3 RX level at or above threshold
+    //   3 - RX data: reading takes the oldest byte and clears the RX error bits
+    //   4 - Interrupt enable: bit 0 RX threshold, bit 1 TX threshold
+    //   5 - Baud divisor: clock cycles per bit, writes below 2 are ignored
+    //   6 - FIFO levels: bits 15:0 RX, bits 31:16 TX
+    //   7 - FIFO thresholds: bits 15:0 RX (reset 1), bits 31:16 TX (reset 0)
+
+    reg [15:0] divisor;
+    reg [15:0] rx_threshold;
+    reg [15:0] tx_threshold;
+    reg [1:0] irq_enable;
+
+    // === TX FIFO ===
     wire tx_busy;
-    wire tx_start = we && addr == 2'b00 && !tx_busy;
+    wire [7:0] tx_fifo_rdata;
+    wire tx_fifo_empty;
+    wire tx_fifo_full;
+    wire [FIFO_ADDR_WIDTH:0] tx_level;
 
-    wire [7:0] rx_data;
-    wire rx_data_ready;
-    wire rx_framing_error;
-    reg [7:0] rx_buffer;
-    reg rx_ready;
-    reg rx_overrun;
-    reg rx_frame_error_status;
+    // Start the next byte as soon as the transmitter is idle; busy rises on
+    // the following cycle so a byte is never started twice
+    wire tx_start = !tx_busy && !tx_fifo_empty;
 
-    // Register map:
-    //   0 - TX data (write-only)
-    //   1 - TX status: bit 0 busy
-    //   2 - RX status: bit 0 ready, bit 1 overrun, bit 2 framing error
-    //   3 - RX data (reading clears RX status)
-
-    uart_tx #(
-        .CLK_FREQ(CLK_FREQ),
-        .BAUD_RATE(BAUD_RATE)
-    ) tx_inst (
+    uart_fifo #(
+        .ADDR_WIDTH(FIFO_ADDR_WIDTH)
+    ) tx_fifo (
+        .clk(clk),
+        .rst(rst),
+        .wdata(wdata[7:0]),
+        .we(we && addr == 3'd0),
+        .re(tx_start),
+        .rdata(tx_fifo_rdata),
+        .empty(tx_fifo_empty),
+        .full(tx_fifo_full),
+        .level(tx_level)
+    );
+
+    uart_tx tx_inst(
         .clk(clk),
         .rst(rst),
-        .data(wdata[7:0]),
+        .divisor(divisor),
+        .data(tx_fifo_rdata),
         .start(tx_start),
         .busy(tx_busy),
         .tx(tx)
     );
 
-    uart_rx #(
-        .CLK_FREQ(CLK_FREQ),
-        .BAUD_RATE(BAUD_RATE)
-    ) rx_inst (
+    // === RX FIFO ===
+    wire [7:0] rx_data;
+    wire rx_data_ready;
+    wire rx_framing_error;
+    wire [7:0] rx_fifo_rdata;
+    wire rx_fifo_empty;
+    wire rx_fifo_full;
+    wire [FIFO_ADDR_WIDTH:0] rx_level;
+    wire rx_pop = re && addr == 3'd3;
+    reg [7:0] rx_buffer;
+    reg rx_overrun;
+    reg rx_frame_error_status;
+
+    uart_rx rx_inst(
         .clk(clk),
         .rst(rst),
+        .divisor(divisor),
         .rx(rx),
         .data_ready(rx_data_ready),
         .framing_error(rx_framing_error),
         .data(rx_data)
     );
 
+    uart_fifo #(
+        .ADDR_WIDTH(FIFO_ADDR_WIDTH)
+    ) rx_fifo (
+        .clk(clk),
+        .rst(rst),
+        .wdata(rx_data),
+        .we(rx_data_ready),
+        .re(rx_pop),
+        .rdata(rx_fifo_rdata),
+        .empty(rx_fifo_empty),
+        .full(rx_fifo_full),
+        .level(rx_level)
+    );
+
+    wire rx_ready = !rx_fifo_empty;
+    wire rx_at_threshold = rx_ready && rx_level >= rx_threshold;
+    wire tx_at_threshold = tx_level <= tx_threshold;
+
+    // Level interrupt, cleared by draining the RX FIFO or filling the TX FIFO
+    assign irq = (irq_enable[0] && rx_at_threshold) || (irq_enable[1] && tx_at_threshold);
+
+    // The CPU samples rdata the cycle after the read strobe, when the FIFO
+    // has already moved on, so RX data reads the byte latched by the strobe
     always @(*) begin
         case (addr)
-            2'b01: rdata = {31'b0, tx_busy};
-            2'b10: rdata = {29'b0, rx_frame_error_status,
-                            rx_overrun, rx_ready};
-            2'b11: rdata = {24'b0, rx_buffer};
+            3'd1: rdata = {29'b0, tx_at_threshold, tx_busy || !tx_fifo_empty,
+                           tx_fifo_full};
+            3'd2: rdata = {28'b0, rx_at_threshold, rx_frame_error_status,
+                           rx_overrun, rx_ready};
+            3'd3: rdata = {24'b0, rx_buffer};
+            3'd4: rdata = {30'b0, irq_enable};
+            3'd5: rdata = {16'b0, divisor};
+            3'd6: rdata = {{(16 - FIFO_ADDR_WIDTH - 1){1'b0}}, tx_level,
+                           {(16 - FIFO_ADDR_WIDTH - 1){1'b0}}, rx_level};
+            3'd7: rdata = {tx_threshold, rx_threshold};
             default: rdata = 0;
         endcase
     end
@@ -72,12 +140,24 @@ module uart #(
     always @(posedge clk) begin
         if (rst) begin
             rx_buffer <= 0;
-            rx_ready <= 0;
             rx_overrun <= 0;
             rx_frame_error_status <= 0;
+            irq_enable <= 2'b00;
+            divisor <= RESET_DIVISOR;
+            rx_threshold <= 16'd1;
+            tx_threshold <= 16'd0;
         end else begin
-            if (re && addr == 2'b11) begin
-                rx_ready <= 0;
+            if (we && addr == 3'd4)
+                irq_enable <= wdata[1:0];
+            if (we && addr == 3'd5 && wdata[15:1] != 15'd0)
+                divisor <= wdata[15:0];
+            if (we && addr == 3'd7) begin
+                rx_threshold <= wdata[15:0];
+                tx_threshold <= wdata[31:16];
+            end
+
+            if (rx_pop) begin
+                rx_buffer <= rx_fifo_empty ? 8'b0 : rx_fifo_rdata;
                 rx_overrun <= 0;
                 rx_frame_error_status <= 0;
             end
@@ -85,12 +165,8 @@ module uart #(
             if (rx_framing_error)
                 rx_frame_error_status <= 1;
 
-            if (rx_data_ready) begin
-                rx_buffer <= rx_data;
-                rx_ready <= 1;
-                if (rx_ready)
-                    rx_overrun <= 1;
-            end
+            if (rx_data_ready && rx_fifo_full)
+                rx_overrun <= 1;
         end
     end
 endmodule
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Byte FIFO with 2^ADDR_WIDTH entries for the UART.
+// The storage has a registered read port so it maps to block RAM. rdata
+// always shows the oldest entry (first-word fall-through); a write into the
+// slot being read is forwarded so a byte is visible the cycle after it is
+// written. Writes when full and reads when empty are ignored.
+module uart_fifo #(
+    parameter integer ADDR_WIDTH = 4
+) (
+    input wire clk,
+    input wire rst,
+    input wire [7:0] wdata,
+    input wire we,
+    input wire re,
+    output wire [7:0] rdata,
+    output wire empty,
+    output wire full,
+    output wire [ADDR_WIDTH:0] level
+);
+    (* syn_ramstyle = "block_ram" *) reg [7:0] mem [0:(1 << ADDR_WIDTH) - 1];
+
+    // Pointers carry one extra lap bit so full and empty can be told apart
+    reg [ADDR_WIDTH:0] wr_ptr;
+    reg [ADDR_WIDTH:0] rd_ptr;
+
+    assign level = wr_ptr - rd_ptr;
+    assign empty = level == 0;
+    assign full = level[ADDR_WIDTH];
+
+    wire push = we && !full;
+    wire pop = re && !empty;
+    wire [ADDR_WIDTH:0] rd_next = rd_ptr + pop;
+
+    reg [7:0] mem_rdata;
+    reg bypass;
+    reg [7:0] bypass_data;
+    assign rdata = bypass ? bypass_data : mem_rdata;
+
+    always @(posedge clk) begin
+        if (push)
+            mem[wr_ptr[ADDR_WIDTH - 1:0]] <= wdata;
+        mem_rdata <= mem[rd_next[ADDR_WIDTH - 1:0]];
+    end
+
+    always @(posedge clk) begin
+        if (rst) begin
+            wr_ptr <= 0;
+            rd_ptr <= 0;
+            bypass <= 0;
+            bypass_data <= 0;
+        end else begin
+            if (push)
+                wr_ptr <= wr_ptr + 1'b1;
+            rd_ptr <= rd_next;
+            bypass <= push && wr_ptr == rd_next;
+            bypass_data <= wdata;
+        end
+    end
+endmodule
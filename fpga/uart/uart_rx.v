@@ -4,25 +4,17 @@
  * SPDX-License-Identifier: MIT
  */
 
-module uart_rx #(
-    parameter integer CLK_FREQ = 27000000,
-    parameter integer BAUD_RATE = 115200
-) (
+// Bit time in clock cycles set at runtime by divisor (at least 2). Change
+// it only while the line is idle.
+module uart_rx(
     input wire clk,
     input wire rst,
+    input wire [15:0] divisor,
     input wire rx,
     output reg data_ready,
     output reg framing_error,
     output reg [7:0] data
 );
-    localparam integer BAUD_DIVISOR =
-        (CLK_FREQ + BAUD_RATE / 2) / BAUD_RATE;
-    localparam integer BAUD_TICKS = BAUD_DIVISOR > 0 ? BAUD_DIVISOR : 1;
-    localparam integer HALF_BAUD_TICKS =
-        BAUD_TICKS > 1 ? BAUD_TICKS / 2 : 1;
-    localparam integer BAUD_COUNTER_WIDTH =
-        BAUD_TICKS > 1 ? $clog2(BAUD_TICKS) : 1;
-
     localparam [1:0] STATE_IDLE  = 2'b00;
     localparam [1:0] STATE_START = 2'b01;
     localparam [1:0] STATE_DATA  = 2'b10;
@@ -32,9 +24,11 @@ module uart_rx #(
     reg rx_sync;
     reg [1:0] state;
     reg [2:0] bit_index;
-    reg [BAUD_COUNTER_WIDTH - 1:0] baud_counter;
+    reg [15:0] baud_counter;
     reg [7:0] data_latch;
 
+    wire [15:0] half_divisor = divisor > 16'd1 ? divisor >> 1 : 16'd1;
+
     always @(posedge clk) begin
         if (rst) begin
             rx_meta <= 1;
@@ -65,7 +59,7 @@ module uart_rx #(
                         state <= STATE_START;
                 end
                 STATE_START: begin
-                    if (baud_counter == HALF_BAUD_TICKS - 1) begin
+                    if (baud_counter == half_divisor - 1'b1) begin
                         baud_counter <= 0;
                         if (!rx_sync) begin
                             bit_index <= 0;
@@ -78,7 +72,7 @@ module uart_rx #(
                     end
                 end
                 STATE_DATA: begin
-                    if (baud_counter == BAUD_TICKS - 1) begin
+                    if (baud_counter == divisor - 1'b1) begin
                         baud_counter <= 0;
                         data_latch[bit_index] <= rx_sync;
                         if (bit_index == 7) begin
@@ -91,7 +85,7 @@ module uart_rx #(
                     end
                 end
                 STATE_STOP: begin
-                    if (baud_counter == BAUD_TICKS - 1) begin
+                    if (baud_counter == divisor - 1'b1) begin
                         baud_counter <= 0;
                         if (rx_sync) begin
                             data <= data_latch;
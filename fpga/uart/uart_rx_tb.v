@@ -20,12 +20,10 @@ module uart_rx_tb;
 
     always #5 clk = ~clk;
 
-    uart_rx #(
-        .CLK_FREQ(100),
-        .BAUD_RATE(10)
-    ) dut (
+    uart_rx dut(
         .clk(clk),
         .rst(rst),
+        .divisor(BAUD_TICKS),
         .rx(rx),
         .data_ready(data_ready),
         .framing_error(framing_error),
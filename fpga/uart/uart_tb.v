@@ -8,22 +8,28 @@
 
 module uart_tb;
     localparam integer BAUD_TICKS = 10;
+    localparam integer FIFO_DEPTH = 4;
 
     reg clk = 0;
     reg rst = 1;
-    reg [1:0] addr = 0;
+    reg [2:0] addr = 0;
     reg [31:0] wdata = 0;
     reg we = 0;
     reg re = 0;
     reg rx = 1;
     wire [31:0] rdata;
     wire tx;
+    wire irq;
+
+    // Current bit time, follows writes to the divisor register
+    integer bit_ticks = BAUD_TICKS;
 
     always #5 clk = ~clk;
 
     uart #(
         .CLK_FREQ(100),
-        .BAUD_RATE(10)
+        .BAUD_RATE(10),
+        .FIFO_DEPTH(FIFO_DEPTH)
     ) dut (
         .clk(clk),
         .rst(rst),
@@ -33,15 +39,43 @@ module uart_tb;
         .re(re),
         .rdata(rdata),
         .rx(rx),
-        .tx(tx)
+        .tx(tx),
+        .irq(irq)
     );
 
-    task write_tx;
-        input [7:0] value;
+    // Decode every byte on the TX line into tx_log
+    reg [7:0] tx_log [0:31];
+    integer tx_count = 0;
+    integer tx_index;
+    reg [7:0] tx_shift;
+    always begin
+        @(negedge tx);
+        repeat (bit_ticks / 2) @(posedge clk);
+        if (tx !== 0)
+            $fatal(1, "TX start bit too short");
+        for (tx_index = 0; tx_index < 8; tx_index = tx_index + 1) begin
+            repeat (bit_ticks) @(posedge clk);
+            tx_shift[tx_index] = tx;
+        end
+        repeat (bit_ticks) @(posedge clk);
+        if (tx !== 1)
+            $fatal(1, "TX stop bit missing");
+        tx_log[tx_count] = tx_shift;
+        tx_count = tx_count + 1;
+    end
+
+    initial begin
+        #1000000;
+        $fatal(1, "uart_tb: timeout");
+    end
+
+    task write_reg;
+        input [2:0] index;
+        input [31:0] value;
         begin
             @(negedge clk);
-            addr = 0;
-            wdata = {24'b0, value};
+            addr = index;
+            wdata = value;
             we = 1;
             @(posedge clk);
             #1;
@@ -49,11 +83,54 @@ module uart_tb;
         end
     endtask
 
+    task write_tx;
+        input [7:0] value;
+        begin
+            write_reg(0, {24'b0, value});
+        end
+    endtask
+
+    task expect_reg;
+        input [2:0] index;
+        input [31:0] expected;
+        begin
+            addr = index;
+            #1;
+            if (rdata !== expected)
+                $fatal(1, "Register %0d: got %08x expected %08x", index, rdata, expected);
+        end
+    endtask
+
+    // Pop one RX byte; the data register holds it from the next cycle
+    task read_rx;
+        input [7:0] expected;
+        begin
+            @(negedge clk);
+            addr = 3;
+            re = 1;
+            @(posedge clk);
+            #1;
+            re = 0;
+            if (rdata !== {24'b0, expected})
+                $fatal(1, "RX data: got %02x expected %02x", rdata[7:0], expected);
+        end
+    endtask
+
+    task expect_tx;
+        input integer index;
+        input [7:0] expected;
+        begin
+            wait (tx_count > index);
+            if (tx_log[index] !== expected)
+                $fatal(1, "TX byte %0d: got %02x expected %02x", index, tx_log[index], expected);
+        end
+    endtask
+
     task send_bit;
         input value;
         begin
             rx = value;
-            repeat (BAUD_TICKS) @(negedge clk);
+            repeat (bit_ticks) @(negedge clk);
         end
     endtask
 
@@ -75,45 +152,106 @@ module uart_tb;
         rst = 0;
         repeat (2) @(posedge clk);
 
+        expect_reg(5, BAUD_TICKS);
+        expect_reg(7, 32'h00000001);
+        expect_reg(1, 32'h00000004);
+
+        // A burst fills the TX FIFO behind the byte being sent; the write
+        // after that is dropped
         write_tx(8'hA6);
-        addr = 1;
-        #1;
-        if (rdata !== 32'h00000001 || tx !== 0)
-            $fatal(1, "TX did not start: status=%08x tx=%b", rdata, tx);
-        repeat (BAUD_TICKS * 10) @(posedge clk);
-        #1;
-        if (rdata !== 0 || tx !== 1)
-            $fatal(1, "TX status did not return to idle");
+        write_tx(8'h5B);
+        write_tx(8'hC3);
+        write_tx(8'h11);
+        write_tx(8'h22);
+        expect_reg(1, 32'h00000003);
+        expect_reg(6, 32'h00040000);
+        write_tx(8'h33);
+        expect_tx(0, 8'hA6);
+        expect_tx(1, 8'h5B);
+        expect_tx(2, 8'hC3);
+        expect_tx(3, 8'h11);
+        expect_tx(4, 8'h22);
+        repeat (bit_ticks * 12) @(posedge clk);
+        if (tx_count !== 5)
+            $fatal(1, "TX sent a byte written while the FIFO was full");
+        expect_reg(1, 32'h00000004);
 
+        // Received bytes queue up in order
         send_byte(8'h12);
-        addr = 2;
-        #1;
-        if (rdata !== 32'h00000001)
-            $fatal(1, "RX ready status was not set");
-        addr = 3;
-        #1;
-        if (rdata !== 32'h00000012)
-            $fatal(1, "RX data register mismatch");
-
-        // Receiving again before reading reports overrun and keeps the latest byte.
         send_byte(8'h34);
-        addr = 2;
-        #1;
-        if (rdata !== 32'h00000003)
-            $fatal(1, "RX overrun status was not set");
-        addr = 3;
-        #1;
-        if (rdata !== 32'h00000034)
-            $fatal(1, "RX buffer did not contain the latest byte");
+        send_byte(8'h56);
+        expect_reg(2, 32'h00000009);
+        expect_reg(6, 32'h00000003);
+        read_rx(8'h12);
+        read_rx(8'h34);
+        read_rx(8'h56);
+        expect_reg(2, 32'h00000000);
 
-        re = 1;
-        @(posedge clk);
-        #1;
-        re = 0;
-        addr = 2;
+        // A byte arriving while the RX FIFO is full is lost and flagged
+        send_byte(8'h01);
+        send_byte(8'h02);
+        send_byte(8'h03);
+        send_byte(8'h04);
+        send_byte(8'h05);
+        expect_reg(2, 32'h0000000B);
+        read_rx(8'h01);
+        expect_reg(2, 32'h00000009);
+        read_rx(8'h02);
+        read_rx(8'h03);
+        read_rx(8'h04);
+        expect_reg(2, 32'h00000000);
+
+        // Interrupts are level sensitive, enabled per source and follow the
+        // FIFO thresholds
+        if (irq !== 0)
+            $fatal(1, "Interrupt raised while disabled");
+        write_reg(7, 32'h00010002);
+        write_reg(4, 32'h1);
+        send_byte(8'h61);
+        if (irq !== 0)
+            $fatal(1, "RX interrupt raised below the threshold");
+        send_byte(8'h62);
+        if (irq !== 1)
+            $fatal(1, "RX interrupt not raised at the threshold");
+        read_rx(8'h61);
+        if (irq !== 0)
+            $fatal(1, "RX interrupt still raised below the threshold");
+        read_rx(8'h62);
+
+        write_reg(4, 32'h2);
+        if (irq !== 1)
+            $fatal(1, "TX interrupt not raised with an empty FIFO");
+        write_tx(8'h71);
+        write_tx(8'h72);
+        write_tx(8'h73);
+        if (irq !== 0)
+            $fatal(1, "TX interrupt raised above the threshold");
+        expect_tx(5, 8'h71);
+        repeat (bit_ticks) @(posedge clk);
         #1;
-        if (rdata !== 0)
-            $fatal(1, "Reading RX data did not clear status");
+        if (irq !== 1)
+            $fatal(1, "TX interrupt not raised at the threshold");
+        expect_tx(6, 8'h72);
+        expect_tx(7, 8'h73);
+        write_reg(4, 32'h0);
+        repeat (bit_ticks) @(posedge clk);
+
+        // A smaller divisor switches both directions to a faster bit rate
+        write_reg(5, 4);
+        bit_ticks = 4;
+        expect_reg(5, 4);
+        write_tx(8'h9C);
+        expect_tx(8, 8'h9C);
+        send_byte(8'hE7);
+        read_rx(8'hE7);
+
+        // Divisors below 2 are ignored
+        write_reg(5, 0);
+        expect_reg(5, 4);
+        write_reg(5, 1);
+        expect_reg(5, 4);
+        write_tx(8'h5A);
+        expect_tx(9, 8'h5A);
 
         $display("uart_tb: PASS");
         $finish;
@@ -4,23 +4,17 @@
  * SPDX-License-Identifier: MIT
  */
 
-module uart_tx #(
-    parameter integer CLK_FREQ = 27000000,
-    parameter integer BAUD_RATE = 115200
-) (
+// Bit time in clock cycles set at runtime by divisor (at least 2). Change
+// it only while the line is idle.
+module uart_tx(
     input wire clk,
     input wire rst,
+    input wire [15:0] divisor,
     input wire [7:0] data,
     input wire start,
     output reg busy,
     output reg tx
 );
-    localparam integer BAUD_DIVISOR =
-        (CLK_FREQ + BAUD_RATE / 2) / BAUD_RATE;
-    localparam integer BAUD_TICKS = BAUD_DIVISOR > 0 ? BAUD_DIVISOR : 1;
-    localparam integer BAUD_COUNTER_WIDTH =
-        BAUD_TICKS > 1 ? $clog2(BAUD_TICKS) : 1;
-
     localparam [1:0] STATE_IDLE  = 2'b00;
     localparam [1:0] STATE_START = 2'b01;
     localparam [1:0] STATE_DATA  = 2'b10;
@@ -28,7 +22,7 @@ module uart_tx #(
 
     reg [1:0] state;
     reg [2:0] bit_index;
-    reg [BAUD_COUNTER_WIDTH - 1:0] baud_counter;
+    reg [15:0] baud_counter;
     reg [7:0] data_latch;
 
     always @(posedge clk) begin
@@ -53,7 +47,7 @@ module uart_tx #(
                     end
                 end
                 STATE_START: begin
-                    if (baud_counter == BAUD_TICKS - 1) begin
+                    if (baud_counter == divisor - 1'b1) begin
                         baud_counter <= 0;
                         bit_index <= 0;
                         tx <= data_latch[0];
@@ -63,7 +57,7 @@ module uart_tx #(
                     end
                 end
                 STATE_DATA: begin
-                    if (baud_counter == BAUD_TICKS - 1) begin
+                    if (baud_counter == divisor - 1'b1) begin
                         baud_counter <= 0;
                         if (bit_index == 7) begin
                             tx <= 1;
@@ -77,7 +71,7 @@ module uart_tx #(
                     end
                 end
                 STATE_STOP: begin
-                    if (baud_counter == BAUD_TICKS - 1) begin
+                    if (baud_counter == divisor - 1'b1) begin
                         baud_counter <= 0;
                         busy <= 0;
                         state <= STATE_IDLE;
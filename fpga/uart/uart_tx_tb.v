@@ -20,12 +20,10 @@ module uart_tx_tb;
 
     always #5 clk = ~clk;
 
-    uart_tx #(
-        .CLK_FREQ(100),
-        .BAUD_RATE(10)
-    ) dut (
+    uart_tx dut(
         .clk(clk),
         .rst(rst),
+        .divisor(BAUD_TICKS),
         .data(data),
         .start(start),
         .busy(busy),
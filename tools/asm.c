@@ -4,9 +4,14 @@
  * SPDX-License-Identifier: MIT
  */
 
-// Basic RV32I assembler - outputs 32-bit hex words (one per line)
-// Supports: all RV32I instructions, common pseudo-instructions,
-// %hi/%lo relocations, labels, GAS-style includes, and basic directives.
+// Basic RV32IMC assembler - outputs 32-bit hex words (one per line), or a raw
+// binary image when the output file ends in .bin. -b sets the load address.
+// Supports: all RV32I, M-extension, Zicsr and Zifencei instructions, MRET and
+// WFI, common pseudo-instructions including the counter reads (rdcycle,
+// rdinstret), %hi/%lo relocations, labels, GAS-style includes, and basic
+// directives.
+// Instructions are emitted in their 16-bit C-extension form whenever the
+// operands allow it; .option norvc / .option rvc turn this off and on.
 
 #include <ctype.h>
 #include <stdint.h>
@@ -21,10 +26,12 @@
 #define MAX_OUTPUT 16384
 #define MAX_PATH_LEN 1024
 #define MAX_INCLUDE_DEPTH 32
+#define MAX_LAYOUT_PASSES 16
 
 // Output buffer (byte-level, emitted as 32-bit words at the end)
 static uint8_t output[MAX_OUTPUT];
 static int output_pos = 0;
+static uint32_t base_address = 0; // address of output[0], set with -b
 
 // Labels
 static struct {
@@ -48,7 +55,24 @@ static int line_count = 0;
 static char include_stack[MAX_INCLUDE_DEPTH][MAX_PATH_LEN];
 
 static int current_line = 0;
-static int pass = 0;  // 0 = collect labels, 1 = emit code
+static int pass = 0;  // 0 = lay out code and collect labels, 1 = emit code
+
+// Layout state. Labels and .equs are defined in the same order on every pass,
+// so each pass updates the entries of the previous one by index.
+static int label_index = 0;
+static int equ_index = 0;
+static int layout_changed = 0;
+
+// Compression state: rvc_enabled follows .option rvc/norvc, line_insn counts
+// the instructions emitted by the current line, and line_wide marks (one bit
+// per instruction) those that needed 32 bits in an earlier pass. That choice
+// is kept, so code only grows between passes and the layout converges. A line
+// that uses a symbol not defined yet (line_unresolved) is not marked, as its
+// operands are not known until the next pass.
+static int rvc_enabled = 1;
+static int line_insn = 0;
+static int line_unresolved = 0;
+static uint8_t line_wide[MAX_LINES];
 
 static void error(const char* msg) {
     fprintf(stderr, "%s:%d: Error: %s\n", source_paths[current_line], source_line_numbers[current_line], msg);
@@ -79,6 +103,35 @@ static void emit_word(uint32_t w) {
     emit_byte((w >> 24) & 0xFF);
 }
 
+static void emit_half(uint16_t h) {
+    emit_byte(h & 0xFF);
+    emit_byte((h >> 8) & 0xFF);
+}
+
+static uint16_t compress_insn(uint32_t insn);
+
+// Emit an instruction, compressed when possible
+static void emit_insn(uint32_t insn) {
+    int bit = 1 << (line_insn < 8 ? line_insn : 7);
+    line_insn++;
+    if (rvc_enabled && !(line_wide[current_line] & bit)) {
+        uint16_t half = compress_insn(insn);
+        if (half != 0) {
+            emit_half(half);
+            return;
+        }
+        if (!line_unresolved)
+            line_wide[current_line] |= bit;
+        layout_changed = 1;
+    }
+    emit_word(insn);
+}
+
+// Address the next emitted byte will be loaded at
+static uint32_t current_address(void) {
+    return base_address + output_pos;
+}
+
 static void align_to(int alignment) {
     while (output_pos % alignment != 0)
         emit_byte(0);
@@ -104,6 +157,19 @@ static void add_label(const char* name, uint32_t addr) {
     label_count++;
 }
 
+static void define_label(const char* name, uint32_t addr) {
+    if (label_index == label_count) {
+        add_label(name, addr);
+        layout_changed = 1;
+    } else if (labels[label_index].addr != addr) {
+        if (pass == 1)
+            error_msg("label moved during the final pass", name);
+        labels[label_index].addr = addr;
+        layout_changed = 1;
+    }
+    label_index++;
+}
+
 // .equ lookup
 static int find_equ(const char* name, int32_t* value) {
     for (int i = 0; i < equ_count; i++) {
@@ -124,6 +190,19 @@ static void add_equ(const char* name, int32_t value) {
     equ_count++;
 }
 
+static void define_equ(const char* name, int32_t value) {
+    if (equ_index == equ_count) {
+        add_equ(name, value);
+        layout_changed = 1;
+    } else if (equs[equ_index].value != value) {
+        if (pass == 1)
+            error_msg(".equ changed during the final pass", name);
+        equs[equ_index].value = value;
+        layout_changed = 1;
+    }
+    equ_index++;
+}
+
 // String trimming
 static char* trim(char* s) {
     while (isspace((unsigned char)*s))
@@ -344,13 +423,45 @@ static int32_t parse_imm(const char* s) {
     if (find_label(s, &addr))
         return (int32_t)addr;
 
-    if (pass == 0)
+    if (pass == 0) {
+        line_unresolved = 1;
         return 0;  // Labels may not be defined yet in pass 0
+    }
 
     error_msg("unknown symbol", s);
     return 0;
 }
 
+// Parse a CSR name or number
+static int parse_csr(const char* s) {
+    struct {
+        const char* name;
+        int addr;
+    } csrs[] = {{"mstatus", 0x300}, {"mie", 0x304},      {"mtvec", 0x305},    {"mscratch", 0x340},
+                {"mepc", 0x341},    {"mcause", 0x342},   {"mtval", 0x343},    {"mip", 0x344},
+                {"mcycle", 0xB00},  {"minstret", 0xB02}, {"mcycleh", 0xB80},  {"minstreth", 0xB82},
+                {"cycle", 0xC00},   {"instret", 0xC02},  {"cycleh", 0xC80},   {"instreth", 0xC82},
+                {NULL, 0}};
+    for (int i = 0; csrs[i].name; i++) {
+        if (strcmp(s, csrs[i].name) == 0)
+            return csrs[i].addr;
+    }
+
+    // mhpmcounter3-31 at 0xB03, hpmcounter3-31 at 0xC03, high halves +0x80
+    int base = strncmp(s, "mhpmcounter", 11) == 0 ? 0xB00 : strncmp(s, "hpmcounter", 10) == 0 ? 0xC00 : 0;
+    if (base) {
+        const char* p = s + (base == 0xB00 ? 11 : 10);
+        char* end;
+        long index = isdigit((unsigned char)*p) ? strtol(p, &end, 10) : 0;
+        if (index >= 3 && index <= 31 && (end[0] == '\0' || (end[0] == 'h' && end[1] == '\0')))
+            return base + (end[0] == 'h' ? 0x80 : 0) + (int)index;
+    }
+    int32_t addr = parse_imm(s);
+    if (addr < 0 || addr > 0xFFF)
+        error_msg("invalid CSR", s);
+    return addr;
+}
+
 // Tokenize a line into parts (splits on commas and whitespace)
 // Returns tokens and count; handles offset(reg) syntax
 static char tokens[16][128];
@@ -475,8 +586,160 @@ static uint32_t enc_j(int imm, int rd) {
     return (imm20 << 31) | (imm10_1 << 21) | (imm11 << 20) | (imm19_12 << 12) | ((rd & 0x1F) << 7) | 0x6F;
 }
 
+// Compressed instruction helpers
+static uint32_t bits(int32_t value, int hi, int lo) {
+    return ((uint32_t)value >> lo) & ((1u << (hi - lo + 1)) - 1);
+}
+
+static int fits_signed(int32_t value, int width) {
+    return value >= -(1 << (width - 1)) && value < (1 << (width - 1));
+}
+
+// x8-x15, the registers reachable from the 3-bit fields
+static int is_creg(int r) {
+    return r >= 8 && r <= 15;
+}
+
+static uint16_t enc_ci(int funct3, int32_t imm, int rd, int op) {
+    return (funct3 << 13) | (bits(imm, 5, 5) << 12) | (rd << 7) | (bits(imm, 4, 0) << 2) | op;
+}
+
+static uint16_t enc_cj(int funct3, int32_t offset) {
+    return (funct3 << 13) | (bits(offset, 11, 11) << 12) | (bits(offset, 4, 4) << 11) | (bits(offset, 9, 8) << 9) |
+           (bits(offset, 10, 10) << 8) | (bits(offset, 6, 6) << 7) | (bits(offset, 7, 7) << 6) |
+           (bits(offset, 3, 1) << 3) | (bits(offset, 5, 5) << 2) | 1;
+}
+
+static uint16_t enc_cb(int funct3, int32_t offset, int rs1) {
+    return (funct3 << 13) | (bits(offset, 8, 8) << 12) | (bits(offset, 4, 3) << 10) | ((rs1 - 8) << 7) |
+           (bits(offset, 7, 6) << 5) | (bits(offset, 2, 1) << 3) | (bits(offset, 5, 5) << 2) | 1;
+}
+
+static uint16_t enc_ca(int funct2, int rd, int rs2) {
+    return (0x23 << 10) | ((rd - 8) << 7) | (funct2 << 5) | ((rs2 - 8) << 2) | 1;
+}
+
+// Returns the 16-bit encoding of a 32-bit instruction, or 0 if there is none
+static uint16_t compress_insn(uint32_t insn) {
+    int opcode = insn & 0x7F;
+    int rd = (insn >> 7) & 0x1F;
+    int funct3 = (insn >> 12) & 0x7;
+    int rs1 = (insn >> 15) & 0x1F;
+    int rs2 = (insn >> 20) & 0x1F;
+    int funct7 = insn >> 25;
+    int32_t imm_i = (int32_t)insn >> 20;
+    int32_t imm_s = ((int32_t)insn >> 25 << 5) | rd;
+    int32_t imm_b = ((int32_t)insn >> 31 << 12) | (bits(insn, 7, 7) << 11) | (bits(insn, 30, 25) << 5) |
+                    (bits(insn, 11, 8) << 1);
+    int32_t imm_j = ((int32_t)insn >> 31 << 20) | (bits(insn, 19, 12) << 12) | (bits(insn, 20, 20) << 11) |
+                    (bits(insn, 30, 21) << 1);
+
+    switch (opcode) {
+        case 0x13:  // OP-IMM
+            if (funct3 == 0) {
+                if (rd == 0 && rs1 == 0 && imm_i == 0)
+                    return 0x0001;  // c.nop
+                if (rd == 0)
+                    return 0;
+                if (rs1 == rd && imm_i != 0 && fits_signed(imm_i, 6))
+                    return enc_ci(0, imm_i, rd, 1);  // c.addi
+                if (rs1 == 0 && fits_signed(imm_i, 6))
+                    return enc_ci(2, imm_i, rd, 1);  // c.li
+                if (rs1 != 0 && imm_i == 0)
+                    return (0x8 << 12) | (rd << 7) | (rs1 << 2) | 2;  // c.mv
+                if (rd == 2 && rs1 == 2 && imm_i != 0 && imm_i % 16 == 0 && fits_signed(imm_i, 10))
+                    return (3 << 13) | (bits(imm_i, 9, 9) << 12) | (2 << 7) | (bits(imm_i, 4, 4) << 6) |
+                           (bits(imm_i, 6, 6) << 5) | (bits(imm_i, 8, 7) << 3) | (bits(imm_i, 5, 5) << 2) |
+                           1;  // c.addi16sp
+                if (is_creg(rd) && rs1 == 2 && imm_i > 0 && imm_i % 4 == 0 && imm_i < 1024)
+                    return (bits(imm_i, 5, 4) << 11) | (bits(imm_i, 9, 6) << 7) | (bits(imm_i, 2, 2) << 6) |
+                           (bits(imm_i, 3, 3) << 5) | ((rd - 8) << 2);  // c.addi4spn
+                return 0;
+            }
+            if (funct3 == 1 && rd != 0 && rs1 == rd && imm_i > 0 && imm_i < 32)
+                return enc_ci(0, imm_i, rd, 2);  // c.slli
+            if (funct3 == 5 && is_creg(rd) && rs1 == rd && (imm_i & 0x1F) != 0 && (imm_i & ~0x41F) == 0)
+                return (4 << 13) | ((imm_i & 0x400) ? 1 << 10 : 0) | ((rd - 8) << 7) | (bits(imm_i, 4, 0) << 2) |
+                       1;  // c.srli, c.srai
+            if (funct3 == 7 && is_creg(rd) && rs1 == rd && fits_signed(imm_i, 6))
+                return (4 << 13) | (bits(imm_i, 5, 5) << 12) | (2 << 10) | ((rd - 8) << 7) | (bits(imm_i, 4, 0) << 2) |
+                       1;  // c.andi
+            return 0;
+
+        case 0x33:  // OP
+            if (funct3 == 0 && funct7 == 0x00 && rd != 0) {
+                if (rs1 == 0 && rs2 != 0)
+                    return (0x8 << 12) | (rd << 7) | (rs2 << 2) | 2;  // c.mv
+                if (rs1 == rd && rs2 != 0)
+                    return (0x9 << 12) | (rd << 7) | (rs2 << 2) | 2;  // c.add
+                if (rs2 == rd && rs1 != 0)
+                    return (0x9 << 12) | (rd << 7) | (rs1 << 2) | 2;  // c.add
+                return 0;
+            }
+            if (!is_creg(rd) || !is_creg(rs1) || !is_creg(rs2))
+                return 0;
+            if (funct3 == 0 && funct7 == 0x20 && rs1 == rd)
+                return enc_ca(0, rd, rs2);  // c.sub
+            if (funct7 == 0x00 && (funct3 == 4 || funct3 == 6 || funct3 == 7) && (rs1 == rd || rs2 == rd)) {
+                int other = rs1 == rd ? rs2 : rs1;
+                return enc_ca(funct3 == 4 ? 1 : funct3 == 6 ? 2 : 3, rd, other);  // c.xor, c.or, c.and
+            }
+            return 0;
+
+        case 0x37:  // LUI
+            if (rd != 0 && rd != 2 && (insn >> 12) != 0 && fits_signed((int32_t)insn >> 12, 6))
+                return enc_ci(3, (int32_t)insn >> 12, rd, 1);  // c.lui
+            return 0;
+
+        case 0x03:  // LOAD
+            if (funct3 != 2)
+                return 0;
+            if (rs1 == 2 && rd != 0 && imm_i >= 0 && imm_i < 256 && imm_i % 4 == 0)
+                return (2 << 13) | (bits(imm_i, 5, 5) << 12) | (rd << 7) | (bits(imm_i, 4, 2) << 4) |
+                       (bits(imm_i, 7, 6) << 2) | 2;  // c.lwsp
+            if (is_creg(rd) && is_creg(rs1) && imm_i >= 0 && imm_i < 128 && imm_i % 4 == 0)
+                return (2 << 13) | (bits(imm_i, 5, 3) << 10) | ((rs1 - 8) << 7) | (bits(imm_i, 2, 2) << 6) |
+                       (bits(imm_i, 6, 6) << 5) | ((rd - 8) << 2);  // c.lw
+            return 0;
+
+        case 0x23:  // STORE
+            if (funct3 != 2)
+                return 0;
+            if (rs1 == 2 && imm_s >= 0 && imm_s < 256 && imm_s % 4 == 0)
+                return (6 << 13) | (bits(imm_s, 5, 2) << 9) | (bits(imm_s, 7, 6) << 7) | (rs2 << 2) | 2;  // c.swsp
+            if (is_creg(rs2) && is_creg(rs1) && imm_s >= 0 && imm_s < 128 && imm_s % 4 == 0)
+                return (6 << 13) | (bits(imm_s, 5, 3) << 10) | ((rs1 - 8) << 7) | (bits(imm_s, 2, 2) << 6) |
+                       (bits(imm_s, 6, 6) << 5) | ((rs2 - 8) << 2);  // c.sw
+            return 0;
+
+        case 0x6F:  // JAL
+            if ((rd == 0 || rd == 1) && fits_signed(imm_j, 12))
+                return enc_cj(rd == 0 ? 5 : 1, imm_j);  // c.j, c.jal
+            return 0;
+
+        case 0x67:  // JALR
+            if (funct3 == 0 && (rd == 0 || rd == 1) && rs1 != 0 && imm_i == 0)
+                return ((rd == 0 ? 0x8 : 0x9) << 12) | (rs1 << 7) | 2;  // c.jr, c.jalr
+            return 0;
+
+        case 0x63:  // BRANCH
+            if ((funct3 == 0 || funct3 == 1) && rs2 == 0 && is_creg(rs1) && fits_signed(imm_b, 9))
+                return enc_cb(funct3 == 0 ? 6 : 7, imm_b, rs1);  // c.beqz, c.bnez
+            return 0;
+
+        case 0x73:  // SYSTEM
+            if (insn == 0x00100073)
+                return 0x9002;  // c.ebreak
+            return 0;
+    }
+    return 0;
+}
+
 // Process one assembly line
 static void process_line(char* raw_line) {
+    line_insn = 0;
+    line_unresolved = 0;
+
     char line[MAX_LINE_LEN];
     strncpy(line, raw_line, MAX_LINE_LEN - 1);
     line[MAX_LINE_LEN - 1] = '\0';
@@ -509,8 +772,7 @@ static void process_line(char* raw_line) {
         }
         if (is_label) {
             *colon = '\0';
-            if (pass == 0)
-                add_label(trimmed, output_pos);
+            define_label(trimmed, current_address());
             trimmed = trim(colon + 1);
             if (!*trimmed)
                 return;
@@ -532,8 +794,19 @@ static void process_line(char* raw_line) {
     if (strcmp(mnem, ".equ") == 0) {
         if (token_count < 3)
             error(".equ requires name and value");
-        if (pass == 0)
-            add_equ(tokens[1], parse_imm(tokens[2]));
+        define_equ(tokens[1], parse_imm(tokens[2]));
+        return;
+    }
+
+    if (strcmp(mnem, ".option") == 0) {
+        if (token_count < 2)
+            error(".option requires argument");
+        if (strcmp(tokens[1], "rvc") == 0)
+            rvc_enabled = 1;
+        else if (strcmp(tokens[1], "norvc") == 0)
+            rvc_enabled = 0;
+        else
+            error_msg("unknown .option", tokens[1]);
         return;
     }
 
@@ -627,7 +900,7 @@ static void process_line(char* raw_line) {
 
     // Pseudo-instructions
     if (strcmp(mnem, "nop") == 0) {
-        emit_word(enc_i(0, 0, 0, 0, 0x13));  // addi x0, x0, 0
+        emit_insn(enc_i(0, 0, 0, 0, 0x13));  // addi x0, x0, 0
         return;
     }
 
@@ -637,13 +910,13 @@ static void process_line(char* raw_line) {
         int rd = parse_reg(tokens[1]);
         int32_t imm = parse_imm(tokens[2]);
         if (imm >= -2048 && imm <= 2047) {
-            emit_word(enc_i(imm, 0, 0, rd, 0x13));  // addi rd, x0, imm
+            emit_insn(enc_i(imm, 0, 0, rd, 0x13));  // addi rd, x0, imm
         } else {
             uint32_t hi = ((uint32_t)(imm + 0x800) >> 12) & 0xFFFFF;
             int32_t lo = imm - (int32_t)(hi << 12);
-            emit_word(enc_u(hi, rd, 0x37));  // lui rd, hi
+            emit_insn(enc_u(hi, rd, 0x37));  // lui rd, hi
             if (lo != 0)
-                emit_word(enc_i(lo & 0xFFF, rd, 0, rd, 0x13));  // addi rd, rd, lo
+                emit_insn(enc_i(lo & 0xFFF, rd, 0, rd, 0x13));  // addi rd, rd, lo
         }
         return;
     }
@@ -653,12 +926,12 @@ static void process_line(char* raw_line) {
             error("la requires rd, symbol");
         int rd = parse_reg(tokens[1]);
         int32_t addr = parse_imm(tokens[2]);
-        uint32_t pc_val = output_pos;
+        uint32_t pc_val = current_address();
         int32_t offset = addr - (int32_t)pc_val;
         uint32_t hi = ((uint32_t)(offset + 0x800) >> 12) & 0xFFFFF;
         int32_t lo = offset - (int32_t)(hi << 12);
-        emit_word(enc_u(hi, rd, 0x17));                 // auipc rd, hi
-        emit_word(enc_i(lo & 0xFFF, rd, 0, rd, 0x13));  // addi rd, rd, lo
+        emit_insn(enc_u(hi, rd, 0x17));                 // auipc rd, hi
+        emit_insn(enc_i(lo & 0xFFF, rd, 0, rd, 0x13));  // addi rd, rd, lo
         return;
     }
 
@@ -667,7 +940,7 @@ static void process_line(char* raw_line) {
             error("mv requires rd, rs");
         int rd = parse_reg(tokens[1]);
         int rs = parse_reg(tokens[2]);
-        emit_word(enc_i(0, rs, 0, rd, 0x13));  // addi rd, rs, 0
+        emit_insn(enc_i(0, rs, 0, rd, 0x13));  // addi rd, rs, 0
         return;
     }
 
@@ -676,7 +949,7 @@ static void process_line(char* raw_line) {
             error("not requires rd, rs");
         int rd = parse_reg(tokens[1]);
         int rs = parse_reg(tokens[2]);
-        emit_word(enc_i(-1, rs, 4, rd, 0x13));  // xori rd, rs, -1
+        emit_insn(enc_i(-1, rs, 4, rd, 0x13));  // xori rd, rs, -1
         return;
     }
 
@@ -685,26 +958,26 @@ static void process_line(char* raw_line) {
             error("neg requires rd, rs");
         int rd = parse_reg(tokens[1]);
         int rs = parse_reg(tokens[2]);
-        emit_word(enc_r(0x20, rs, 0, 0, rd, 0x33));  // sub rd, x0, rs
+        emit_insn(enc_r(0x20, rs, 0, 0, rd, 0x33));  // sub rd, x0, rs
         return;
     }
 
     if (strcmp(mnem, "seqz") == 0) {
         int rd = parse_reg(tokens[1]);
         int rs = parse_reg(tokens[2]);
-        emit_word(enc_i(1, rs, 3, rd, 0x13));  // sltiu rd, rs, 1
+        emit_insn(enc_i(1, rs, 3, rd, 0x13));  // sltiu rd, rs, 1
         return;
     }
 
     if (strcmp(mnem, "snez") == 0) {
         int rd = parse_reg(tokens[1]);
         int rs = parse_reg(tokens[2]);
-        emit_word(enc_r(0, rs, 0, 3, rd, 0x33));  // sltu rd, x0, rs
+        emit_insn(enc_r(0, rs, 0, 3, rd, 0x33));  // sltu rd, x0, rs
         return;
     }
 
     if (strcmp(mnem, "ret") == 0) {
-        emit_word(enc_i(0, 1, 0, 0, 0x67));  // jalr x0, ra, 0
+        emit_insn(enc_i(0, 1, 0, 0, 0x67));  // jalr x0, ra, 0
         return;
     }
 
@@ -712,11 +985,11 @@ static void process_line(char* raw_line) {
         if (token_count < 2)
             error("call requires symbol");
         int32_t target = parse_imm(tokens[1]);
-        int32_t offset = target - (int32_t)output_pos;
+        int32_t offset = target - (int32_t)current_address();
         uint32_t hi = ((uint32_t)(offset + 0x800) >> 12) & 0xFFFFF;
         int32_t lo = offset - (int32_t)(hi << 12);
-        emit_word(enc_u(hi, 1, 0x17));                // auipc ra, hi
-        emit_word(enc_i(lo & 0xFFF, 1, 0, 1, 0x67));  // jalr ra, ra, lo
+        emit_insn(enc_u(hi, 1, 0x17));                // auipc ra, hi
+        emit_insn(enc_i(lo & 0xFFF, 1, 0, 1, 0x67));  // jalr ra, ra, lo
         return;
     }
 
@@ -724,8 +997,8 @@ static void process_line(char* raw_line) {
         if (token_count < 2)
             error("j requires target");
         int32_t target = parse_imm(tokens[1]);
-        int32_t offset = target - (int32_t)output_pos;
-        emit_word(enc_j(offset, 0));  // jal x0, offset
+        int32_t offset = target - (int32_t)current_address();
+        emit_insn(enc_j(offset, 0));  // jal x0, offset
         return;
     }
 
@@ -733,7 +1006,7 @@ static void process_line(char* raw_line) {
         if (token_count < 2)
             error("jr requires rs");
         int rs = parse_reg(tokens[1]);
-        emit_word(enc_i(0, rs, 0, 0, 0x67));  // jalr x0, rs, 0
+        emit_insn(enc_i(0, rs, 0, 0, 0x67));  // jalr x0, rs, 0
         return;
     }
 
@@ -741,43 +1014,43 @@ static void process_line(char* raw_line) {
     if (strcmp(mnem, "beqz") == 0) {
         int rs = parse_reg(tokens[1]);
         int32_t target = parse_imm(tokens[2]);
-        int32_t offset = target - (int32_t)output_pos;
-        emit_word(enc_b(offset, 0, rs, 0));  // beq rs, x0, offset
+        int32_t offset = target - (int32_t)current_address();
+        emit_insn(enc_b(offset, 0, rs, 0));  // beq rs, x0, offset
         return;
     }
     if (strcmp(mnem, "bnez") == 0) {
         int rs = parse_reg(tokens[1]);
         int32_t target = parse_imm(tokens[2]);
-        int32_t offset = target - (int32_t)output_pos;
-        emit_word(enc_b(offset, 0, rs, 1));
+        int32_t offset = target - (int32_t)current_address();
+        emit_insn(enc_b(offset, 0, rs, 1));
         return;
     }
     if (strcmp(mnem, "blez") == 0) {
         int rs = parse_reg(tokens[1]);
         int32_t target = parse_imm(tokens[2]);
-        int32_t offset = target - (int32_t)output_pos;
-        emit_word(enc_b(offset, rs, 0, 5));  // bge x0, rs, offset
+        int32_t offset = target - (int32_t)current_address();
+        emit_insn(enc_b(offset, rs, 0, 5));  // bge x0, rs, offset
         return;
     }
     if (strcmp(mnem, "bgez") == 0) {
         int rs = parse_reg(tokens[1]);
         int32_t target = parse_imm(tokens[2]);
-        int32_t offset = target - (int32_t)output_pos;
-        emit_word(enc_b(offset, 0, rs, 5));  // bge rs, x0, offset
+        int32_t offset = target - (int32_t)current_address();
+        emit_insn(enc_b(offset, 0, rs, 5));  // bge rs, x0, offset
         return;
     }
     if (strcmp(mnem, "bltz") == 0) {
         int rs = parse_reg(tokens[1]);
         int32_t target = parse_imm(tokens[2]);
-        int32_t offset = target - (int32_t)output_pos;
-        emit_word(enc_b(offset, 0, rs, 4));  // blt rs, x0, offset
+        int32_t offset = target - (int32_t)current_address();
+        emit_insn(enc_b(offset, 0, rs, 4));  // blt rs, x0, offset
         return;
     }
     if (strcmp(mnem, "bgtz") == 0) {
         int rs = parse_reg(tokens[1]);
         int32_t target = parse_imm(tokens[2]);
-        int32_t offset = target - (int32_t)output_pos;
-        emit_word(enc_b(offset, rs, 0, 4));  // blt x0, rs, offset
+        int32_t offset = target - (int32_t)current_address();
+        emit_insn(enc_b(offset, rs, 0, 4));  // blt x0, rs, offset
         return;
     }
 
@@ -786,9 +1059,11 @@ static void process_line(char* raw_line) {
         const char* name;
         int funct7;
         int funct3;
-    } r_insns[] = {{"add", 0x00, 0},  {"sub", 0x20, 0}, {"sll", 0x00, 1}, {"slt", 0x00, 2},
-                   {"sltu", 0x00, 3}, {"xor", 0x00, 4}, {"srl", 0x00, 5}, {"sra", 0x20, 5},
-                   {"or", 0x00, 6},   {"and", 0x00, 7}, {NULL, 0, 0}};
+    } r_insns[] = {{"add", 0x00, 0},    {"sub", 0x20, 0},  {"sll", 0x00, 1},    {"slt", 0x00, 2},
+                   {"sltu", 0x00, 3},   {"xor", 0x00, 4},  {"srl", 0x00, 5},    {"sra", 0x20, 5},
+                   {"or", 0x00, 6},     {"and", 0x00, 7},  {"mul", 0x01, 0},    {"mulh", 0x01, 1},
+                   {"mulhsu", 0x01, 2}, {"mulhu", 0x01, 3}, {"div", 0x01, 4},   {"divu", 0x01, 5},
+                   {"rem", 0x01, 6},    {"remu", 0x01, 7}, {NULL, 0, 0}};
     for (int i = 0; r_insns[i].name; i++) {
         if (strcmp(mnem, r_insns[i].name) == 0) {
             if (token_count < 4)
@@ -796,7 +1071,7 @@ static void process_line(char* raw_line) {
             int rd = parse_reg(tokens[1]);
             int rs1 = parse_reg(tokens[2]);
             int rs2 = parse_reg(tokens[3]);
-            emit_word(enc_r(r_insns[i].funct7, rs2, rs1, r_insns[i].funct3, rd, 0x33));
+            emit_insn(enc_r(r_insns[i].funct7, rs2, rs1, r_insns[i].funct3, rd, 0x33));
             return;
         }
     }
@@ -813,7 +1088,7 @@ static void process_line(char* raw_line) {
             int rd = parse_reg(tokens[1]);
             int rs1 = parse_reg(tokens[2]);
             int32_t imm = parse_imm(tokens[3]);
-            emit_word(enc_i(imm, rs1, i_alu[i].funct3, rd, 0x13));
+            emit_insn(enc_i(imm, rs1, i_alu[i].funct3, rd, 0x13));
             return;
         }
     }
@@ -823,21 +1098,21 @@ static void process_line(char* raw_line) {
         int rd = parse_reg(tokens[1]);
         int rs1 = parse_reg(tokens[2]);
         int shamt = parse_imm(tokens[3]) & 0x1F;
-        emit_word(enc_i(shamt, rs1, 1, rd, 0x13));
+        emit_insn(enc_i(shamt, rs1, 1, rd, 0x13));
         return;
     }
     if (strcmp(mnem, "srli") == 0) {
         int rd = parse_reg(tokens[1]);
         int rs1 = parse_reg(tokens[2]);
         int shamt = parse_imm(tokens[3]) & 0x1F;
-        emit_word(enc_i(shamt, rs1, 5, rd, 0x13));
+        emit_insn(enc_i(shamt, rs1, 5, rd, 0x13));
         return;
     }
     if (strcmp(mnem, "srai") == 0) {
         int rd = parse_reg(tokens[1]);
         int rs1 = parse_reg(tokens[2]);
         int shamt = parse_imm(tokens[3]) & 0x1F;
-        emit_word(enc_i(0x400 | shamt, rs1, 5, rd, 0x13));
+        emit_insn(enc_i(0x400 | shamt, rs1, 5, rd, 0x13));
         return;
     }
 
@@ -854,7 +1129,7 @@ static void process_line(char* raw_line) {
             int rd = parse_reg(tokens[1]);
             int32_t offset = parse_imm(tokens[2]);
             int rs1 = parse_reg(tokens[3]);
-            emit_word(enc_i(offset, rs1, loads[i].funct3, rd, 0x03));
+            emit_insn(enc_i(offset, rs1, loads[i].funct3, rd, 0x03));
             return;
         }
     }
@@ -872,7 +1147,7 @@ static void process_line(char* raw_line) {
             int rs2 = parse_reg(tokens[1]);
             int32_t offset = parse_imm(tokens[2]);
             int rs1 = parse_reg(tokens[3]);
-            emit_word(enc_s(offset, rs2, rs1, stores[i].funct3, 0x23));
+            emit_insn(enc_s(offset, rs2, rs1, stores[i].funct3, 0x23));
             return;
         }
     }
@@ -889,8 +1164,8 @@ static void process_line(char* raw_line) {
             int rs1 = parse_reg(tokens[1]);
             int rs2 = parse_reg(tokens[2]);
             int32_t target = parse_imm(tokens[3]);
-            int32_t offset = target - (int32_t)output_pos;
-            emit_word(enc_b(offset, rs2, rs1, branches[i].funct3));
+            int32_t offset = target - (int32_t)current_address();
+            emit_insn(enc_b(offset, rs2, rs1, branches[i].funct3));
             return;
         }
     }
@@ -901,7 +1176,7 @@ static void process_line(char* raw_line) {
             error("lui requires rd, imm");
         int rd = parse_reg(tokens[1]);
         int32_t imm = parse_imm(tokens[2]);
-        emit_word(enc_u(imm, rd, 0x37));
+        emit_insn(enc_u(imm, rd, 0x37));
         return;
     }
 
@@ -911,7 +1186,7 @@ static void process_line(char* raw_line) {
             error("auipc requires rd, imm");
         int rd = parse_reg(tokens[1]);
         int32_t imm = parse_imm(tokens[2]);
-        emit_word(enc_u(imm, rd, 0x17));
+        emit_insn(enc_u(imm, rd, 0x17));
         return;
     }
 
@@ -920,14 +1195,14 @@ static void process_line(char* raw_line) {
         if (token_count == 2) {
             // jal target (rd = ra)
             int32_t target = parse_imm(tokens[1]);
-            int32_t offset = target - (int32_t)output_pos;
-            emit_word(enc_j(offset, 1));
+            int32_t offset = target - (int32_t)current_address();
+            emit_insn(enc_j(offset, 1));
         } else if (token_count >= 3) {
             // jal rd, target
             int rd = parse_reg(tokens[1]);
             int32_t target = parse_imm(tokens[2]);
-            int32_t offset = target - (int32_t)output_pos;
-            emit_word(enc_j(offset, rd));
+            int32_t offset = target - (int32_t)current_address();
+            emit_insn(enc_j(offset, rd));
         } else {
             error("jal requires target");
         }
@@ -939,18 +1214,18 @@ static void process_line(char* raw_line) {
         if (token_count == 2) {
             // jalr rs1 (rd = ra, offset = 0)
             int rs1 = parse_reg(tokens[1]);
-            emit_word(enc_i(0, rs1, 0, 1, 0x67));
+            emit_insn(enc_i(0, rs1, 0, 1, 0x67));
         } else if (token_count >= 4) {
             // jalr rd, rs1, offset  OR  jalr rd, offset(rs1)
             int rd = parse_reg(tokens[1]);
             int32_t offset = parse_imm(tokens[2]);
             int rs1 = parse_reg(tokens[3]);
-            emit_word(enc_i(offset, rs1, 0, rd, 0x67));
+            emit_insn(enc_i(offset, rs1, 0, rd, 0x67));
         } else if (token_count == 3) {
             // jalr rd, rs1 (offset = 0)
             int rd = parse_reg(tokens[1]);
             int rs1 = parse_reg(tokens[2]);
-            emit_word(enc_i(0, rs1, 0, rd, 0x67));
+            emit_insn(enc_i(0, rs1, 0, rd, 0x67));
         } else {
             error("jalr requires arguments");
         }
@@ -959,39 +1234,134 @@ static void process_line(char* raw_line) {
 
     // FENCE
     if (strcmp(mnem, "fence") == 0) {
-        emit_word(0x0000000F);
+        emit_insn(0x0000000F);
+        return;
+    }
+    if (strcmp(mnem, "fence.i") == 0) {
+        emit_insn(0x0000100F);
         return;
     }
 
     // ECALL / EBREAK
     if (strcmp(mnem, "ecall") == 0) {
-        emit_word(0x00000073);
+        emit_insn(0x00000073);
         return;
     }
     if (strcmp(mnem, "ebreak") == 0) {
-        emit_word(0x00100073);
+        emit_insn(0x00100073);
+        return;
+    }
+
+    // MRET / WFI
+    if (strcmp(mnem, "mret") == 0) {
+        emit_insn(0x30200073);
+        return;
+    }
+    if (strcmp(mnem, "wfi") == 0) {
+        emit_insn(0x10500073);
         return;
     }
 
+    // CSR instructions; the immediate forms put a 5-bit value in rs1
+    struct {
+        const char* name;
+        int funct3;
+    } csr_insns[] = {{"csrrw", 1},  {"csrrs", 2},  {"csrrc", 3}, {"csrrwi", 5},
+                     {"csrrsi", 6}, {"csrrci", 7}, {NULL, 0}};
+    for (int i = 0; csr_insns[i].name; i++) {
+        if (strcmp(mnem, csr_insns[i].name) == 0) {
+            if (token_count < 4)
+                error("CSR instruction requires rd, csr, rs1");
+            int rd = parse_reg(tokens[1]);
+            int csr = parse_csr(tokens[2]);
+            int rs1 = csr_insns[i].funct3 & 4 ? parse_imm(tokens[3]) & 0x1F : parse_reg(tokens[3]);
+            emit_insn(enc_i(csr, rs1, csr_insns[i].funct3, rd, 0x73));
+            return;
+        }
+    }
+
+    // CSR pseudo-instructions. There is no time CSR: mtime lives in the
+    // memory-mapped timer.
+    struct {
+        const char* name;
+        int csr;
+    } counter_reads[] = {{"rdcycle", 0xC00},  {"rdinstret", 0xC02},  {"rdcycleh", 0xC80},
+                         {"rdinstreth", 0xC82}, {NULL, 0}};
+    for (int i = 0; counter_reads[i].name; i++) {
+        if (strcmp(mnem, counter_reads[i].name) == 0) {
+            if (token_count < 2)
+                error("counter read requires rd");
+            emit_insn(enc_i(counter_reads[i].csr, 0, 2, parse_reg(tokens[1]), 0x73));  // csrrs rd, csr, x0
+            return;
+        }
+    }
+    if (strcmp(mnem, "csrr") == 0) {
+        if (token_count < 3)
+            error("csrr requires rd, csr");
+        int rd = parse_reg(tokens[1]);
+        emit_insn(enc_i(parse_csr(tokens[2]), 0, 2, rd, 0x73));  // csrrs rd, csr, x0
+        return;
+    }
+    struct {
+        const char* name;
+        int funct3;
+    } csr_writes[] = {{"csrw", 1}, {"csrs", 2}, {"csrc", 3}, {"csrwi", 5}, {"csrsi", 6}, {"csrci", 7}, {NULL, 0}};
+    for (int i = 0; csr_writes[i].name; i++) {
+        if (strcmp(mnem, csr_writes[i].name) == 0) {
+            if (token_count < 3)
+                error("CSR write requires csr, rs1");
+            int csr = parse_csr(tokens[1]);
+            int rs1 = csr_writes[i].funct3 & 4 ? parse_imm(tokens[2]) & 0x1F : parse_reg(tokens[2]);
+            emit_insn(enc_i(csr, rs1, csr_writes[i].funct3, 0, 0x73));  // csrrX x0, csr, rs1
+            return;
+        }
+    }
+
     error_msg("unknown instruction", mnem);
 }
 
 int main(int argc, char* argv[]) {
-    if (argc < 2) {
-        fprintf(stderr, "Usage: %s <input.s> [output.mem]\n", argv[0]);
+    int arg = 1;
+    if (arg + 1 < argc && strcmp(argv[arg], "-b") == 0) {
+        base_address = (uint32_t)strtoul(argv[arg + 1], NULL, 0);
+        arg += 2;
+    }
+    if (arg >= argc) {
+        fprintf(stderr, "Usage: %s [-b base_address] <input.s> [output.mem|output.bin]\n", argv[0]);
         return 1;
     }
+    if (base_address % 4 != 0) {
+        fprintf(stderr, "Error: base address must be word aligned\n");
+        return 1;
+    }
+    const char* input_path = argv[arg];
+    const char* output_path = arg + 1 < argc ? argv[arg + 1] : NULL;
 
-    load_source_file(argv[1], 0);
+    load_source_file(input_path, 0);
 
-    // Pass 0: collect labels
+    // Pass 0: lay out the code and collect labels. Compressing an instruction
+    // moves the labels after it, so repeat until nothing changes any more.
     pass = 0;
-    output_pos = 0;
-    for (current_line = 0; current_line < line_count; current_line++)
-        process_line(lines[current_line]);
+    int layout_passes = 0;
+    do {
+        if (layout_passes++ == MAX_LAYOUT_PASSES) {
+            fprintf(stderr, "Error: code layout did not settle after %d passes\n", MAX_LAYOUT_PASSES);
+            return 1;
+        }
+        layout_changed = 0;
+        label_index = 0;
+        equ_index = 0;
+        rvc_enabled = 1;
+        output_pos = 0;
+        for (current_line = 0; current_line < line_count; current_line++)
+            process_line(lines[current_line]);
+    } while (layout_changed);
 
     // Pass 1: emit code
     pass = 1;
+    label_index = 0;
+    equ_index = 0;
+    rvc_enabled = 1;
     output_pos = 0;
     for (current_line = 0; current_line < line_count; current_line++)
         process_line(lines[current_line]);
@@ -1000,12 +1370,25 @@ int main(int argc, char* argv[]) {
     while (output_pos % 4 != 0)
         output[output_pos++] = 0;
 
+    // A .bin output is the raw image, e.g. for the UART loader
+    size_t output_path_len = output_path ? strlen(output_path) : 0;
+    if (output_path_len > 4 && strcmp(output_path + output_path_len - 4, ".bin") == 0) {
+        FILE* fbin = fopen(output_path, "wb");
+        if (!fbin) {
+            fprintf(stderr, "Cannot open output file: %s\n", output_path);
+            return 1;
+        }
+        fwrite(output, 1, output_pos, fbin);
+        fclose(fbin);
+        return 0;
+    }
+
     // Output
     FILE* fout = stdout;
-    if (argc >= 3) {
-        fout = fopen(argv[2], "w");
+    if (output_path) {
+        fout = fopen(output_path, "w");
         if (!fout) {
-            fprintf(stderr, "Cannot open output file: %s\n", argv[2]);
+            fprintf(stderr, "Cannot open output file: %s\n", output_path);
             return 1;
         }
     }
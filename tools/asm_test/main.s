@@ -1,2 +1,24 @@
+.option norvc
 .include "constants.s"
 .include "nested/code.s"
+mul a2, a0, a1
+.option rvc
+li a1, 7
+addi sp, sp, -64
+lw a0, 4(sp)
+sw a0, 8(a1)
+add a0, a0, a1
+lui a0, 0x12345
+mv a2, a0
+loop:
+bnez a0, loop
+j loop
+csrrw a0, mstatus, a1
+csrsi mstatus, 8
+mret
+wfi
+rdcycle a0
+csrr a1, mhpmcounter3h
+beqz a0, forward
+j forward
+forward:
@@ -0,0 +1,172 @@
+; Copyright (c) 2026 Bastiaan van der Plaat
+; SPDX-License-Identifier: MIT
+
+; Counter CSR test ROM, run on both CPU cores by make test. Checks that
+; mcycle and minstret count, that writes to both halves of them stick and
+; that the low half carries into the high half, and that every event counter
+; counts at least the events of a loop made for it. s0 counts the cases for
+; tools/test_report.s.
+
+.include "../../boot/consts.s"
+
+.equ TEST_ACCESSES, 16
+.equ TEST_HIGH,     0x12345678
+.equ TEST_LOW,      0x10000
+
+_start:
+    addi s0, zero, 0
+    addi s1, zero, TEST_ACCESSES
+
+    ; cycle counts up, and reads the same through both names
+    addi s0, s0, 1
+    rdcycle a0
+    csrr a1, mcycle
+    bgeu a0, a1, fail
+
+    ; instret counts the first read and the four instructions after it
+    addi s0, s0, 1
+    rdinstret a0
+    nop
+    nop
+    nop
+    nop
+    csrr a1, minstret
+    sub a1, a1, a0
+    addi a2, zero, 5
+    bne a1, a2, fail
+
+    ; mcycle keeps counting from a written value
+    addi s0, s0, 1
+    li a2, TEST_LOW
+    csrw mcycle, a2
+    csrr a0, mcycle
+    bltu a0, a2, fail
+    addi a2, a2, 256
+    bgeu a0, a2, fail
+
+    ; minstret takes a written value, counting at most the two instructions
+    ; that write and read it
+    addi s0, s0, 1
+    li a2, TEST_LOW
+    csrw minstret, a2
+    csrr a0, minstret
+    bltu a0, a2, fail
+    addi a2, a2, 3
+    bgeu a0, a2, fail
+
+    ; The high halves are written separately
+    addi s0, s0, 1
+    li a2, TEST_HIGH
+    csrw mcycleh, a2
+    csrr a0, cycleh
+    bne a0, a2, fail
+    addi s0, s0, 1
+    csrw minstreth, a2
+    csrr a0, instreth
+    bne a0, a2, fail
+
+    ; and count up when the low half wraps around
+    addi s0, s0, 1
+    li a0, -256
+    csrw mcycle, a0
+    addi a1, zero, 256
+cycle_wrap_loop:
+    addi a1, a1, -1
+    bne a1, zero, cycle_wrap_loop
+    csrr a0, mcycleh
+    addi a3, a2, 1
+    bne a0, a3, fail
+    addi s0, s0, 1
+    li a0, -4
+    csrw minstret, a0
+    nop
+    nop
+    nop
+    nop
+    csrr a0, minstreth
+    bne a0, a3, fail
+
+    ; Stores and taken branches, from a loop of stores to the RAM
+    addi s0, s0, 1
+    csrw mhpmcounter4, zero
+    csrw mhpmcounter5, zero
+    li a0, BUF_ADDR
+    mv a1, s1
+store_loop:
+    sw zero, 0(a0)
+    addi a1, a1, -1
+    bne a1, zero, store_loop
+    csrr a0, hpmcounter4
+    bltu a0, s1, fail
+    addi s0, s0, 1
+    csrr a0, hpmcounter5
+    addi a1, s1, -1
+    bltu a0, a1, fail
+
+    ; Bus accesses per region, from loads. PSRAM loads one cache line apart
+    ; all miss, so they also make the core wait on loads.
+    addi s0, s0, 1
+    csrw mhpmcounter6, zero
+    li a0, UART_TX_STATUS
+    addi a1, zero, 0
+    jal ra, load_loop
+    csrr a0, hpmcounter6
+    bltu a0, s1, fail
+
+    addi s0, s0, 1
+    csrw mhpmcounter7, zero
+    li a0, VIDEO_BASE
+    addi a1, zero, 4
+    jal ra, load_loop
+    csrr a0, hpmcounter7
+    bltu a0, s1, fail
+
+    addi s0, s0, 1
+    csrw mhpmcounter8, zero
+    li a0, BUF_ADDR
+    addi a1, zero, 4
+    jal ra, load_loop
+    csrr a0, hpmcounter8
+    bltu a0, s1, fail
+
+    addi s0, s0, 1
+    csrw mhpmcounter9, zero
+    addi a0, zero, 0           ; ROM
+    addi a1, zero, 4
+    jal ra, load_loop
+    csrr a0, hpmcounter9
+    bltu a0, s1, fail
+
+    addi s0, s0, 1
+    csrw mhpmcounter3, zero
+    csrw mhpmcounter10, zero
+    li a0, PSRAM_BASE
+    addi a1, zero, 64
+    jal ra, load_loop
+    csrr a0, hpmcounter10
+    bltu a0, s1, fail
+    addi s0, s0, 1
+    csrr a0, hpmcounter3
+    beq a0, zero, fail
+
+    la a1, str_name
+    j test_pass
+
+fail:
+    la a1, str_name
+    j test_fail
+
+; Load TEST_ACCESSES words starting at a0, a1 bytes apart
+load_loop:
+    mv t0, s1
+load_loop_next:
+    lw t1, 0(a0)
+    add a0, a0, a1
+    addi t0, t0, -1
+    bne t0, zero, load_loop_next
+    ret
+
+.include "../test_report.s"
+
+str_name:
+    .asciz "Counter test"
@@ -0,0 +1,297 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Send a RAM image to the boot firmware's UART loader (boot/loader.s)
+// Types the "load" command at the console rate, sends the length, CRC-32 and
+// UART divisor header, switches to the -b rate once the header is ACKed and
+// then sends the image in chunks, waiting for the ACK after each step. With
+// --stream the same bytes are written to files without waiting, as RX input
+// for the simulators.
+
+#define _DEFAULT_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <termios.h>
+#include <unistd.h>
+
+#define CLK_FREQ 27000000   // fpga/top.v
+#define CONSOLE_BAUD 115200  // uart.v rate after reset
+#define LOAD_MAX 0x2800
+#define LOAD_CHUNK 256
+#define ACK 0x06
+#define NAK 0x15
+#define REPLY_TIMEOUT 20  // tenths of a second
+
+static uint8_t image[LOAD_MAX];
+
+// zlib-compatible CRC-32 a nibble at a time, with the table of boot/loader.s
+static uint32_t crc32(const uint8_t* data, size_t length) {
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < length; i++) {
+        crc ^= data[i];
+        crc = (crc >> 4) ^ table[crc & 15];
+        crc = (crc >> 4) ^ table[crc & 15];
+    }
+    return ~crc;
+}
+
+// uart.v divisor for baud: clock cycles per bit
+static long baud_divisor(long baud) {
+    return (CLK_FREQ + baud / 2) / baud;
+}
+
+static void put_le32(uint8_t* dest, uint32_t value) {
+    for (int i = 0; i < 4; i++)
+        dest[i] = (uint8_t)(value >> (8 * i));
+}
+
+static speed_t baud_to_speed(long baud) {
+    switch (baud) {
+        case 9600:
+            return B9600;
+        case 19200:
+            return B19200;
+        case 38400:
+            return B38400;
+        case 57600:
+            return B57600;
+        case 115200:
+            return B115200;
+        case 230400:
+            return B230400;
+#ifdef B460800
+        case 460800:
+            return B460800;
+#endif
+#ifdef B921600
+        case 921600:
+            return B921600;
+#endif
+#ifdef B1000000
+        case 1000000:
+            return B1000000;
+#endif
+#ifdef B2000000
+        case 2000000:
+            return B2000000;
+#endif
+#ifdef B3000000
+        case 3000000:
+            return B3000000;
+#endif
+        default:
+            return 0;
+    }
+}
+
+// Change the port speed once everything written so far has been sent
+static int set_baud(int fd, long baud) {
+    struct termios tio;
+    if (tcdrain(fd) != 0 || tcgetattr(fd, &tio) != 0) {
+        fprintf(stderr, "Cannot configure serial port: %s\n", strerror(errno));
+        return -1;
+    }
+    cfsetispeed(&tio, baud_to_speed(baud));
+    cfsetospeed(&tio, baud_to_speed(baud));
+    if (tcsetattr(fd, TCSANOW, &tio) != 0) {
+        fprintf(stderr, "Cannot configure serial port: %s\n", strerror(errno));
+        return -1;
+    }
+    return 0;
+}
+
+static int open_port(const char* path) {
+    int fd = open(path, O_RDWR | O_NOCTTY);
+    if (fd < 0) {
+        fprintf(stderr, "Cannot open serial port %s: %s\n", path, strerror(errno));
+        return -1;
+    }
+
+    // Raw 8N1, reads time out after REPLY_TIMEOUT
+    struct termios tio;
+    if (tcgetattr(fd, &tio) != 0) {
+        fprintf(stderr, "Cannot configure serial port %s: %s\n", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    tio.c_iflag &= ~(IGNBRK | BRKINT | PARMRK | ISTRIP | INLCR | IGNCR | ICRNL | IXON | IXOFF);
+    tio.c_oflag &= ~OPOST;
+    tio.c_lflag &= ~(ECHO | ECHONL | ICANON | ISIG | IEXTEN);
+    tio.c_cflag &= ~(CSIZE | PARENB | CSTOPB | CRTSCTS);
+    tio.c_cflag |= CS8 | CREAD | CLOCAL;
+    tio.c_cc[VMIN] = 0;
+    tio.c_cc[VTIME] = REPLY_TIMEOUT;
+    cfsetispeed(&tio, baud_to_speed(CONSOLE_BAUD));
+    cfsetospeed(&tio, baud_to_speed(CONSOLE_BAUD));
+    if (tcsetattr(fd, TCSANOW, &tio) != 0) {
+        fprintf(stderr, "Cannot configure serial port %s: %s\n", path, strerror(errno));
+        close(fd);
+        return -1;
+    }
+    tcflush(fd, TCIOFLUSH);
+    return fd;
+}
+
+static int write_all(int fd, const uint8_t* data, size_t length) {
+    while (length > 0) {
+        ssize_t written = write(fd, data, length);
+        if (written < 0) {
+            if (errno == EINTR)
+                continue;
+            fprintf(stderr, "Serial write failed: %s\n", strerror(errno));
+            return -1;
+        }
+        data += written;
+        length -= (size_t)written;
+    }
+    return 0;
+}
+
+// Wait for ACK or NAK; other bytes are skipped when skip_other is set (the
+// REPL echo before the loader starts)
+static int read_reply(int fd, const char* step, int skip_other) {
+    for (;;) {
+        uint8_t byte;
+        ssize_t count = read(fd, &byte, 1);
+        if (count < 0 && errno == EINTR)
+            continue;
+        if (count <= 0) {
+            fprintf(stderr, "No reply from the loader (%s)\n", step);
+            return -1;
+        }
+        if (byte == ACK)
+            return 0;
+        if (byte == NAK) {
+            fprintf(stderr, "Loader rejected the %s\n", step);
+            return -1;
+        }
+        if (!skip_other) {
+            fprintf(stderr, "Unexpected reply 0x%02x from the loader (%s)\n", byte, step);
+            return -1;
+        }
+    }
+}
+
+// Send the whole exchange, switching to baud after the header; fd < 0 writes
+// the host side to stream instead, with the image to image_stream
+static int send_image(int fd, FILE* stream, FILE* image_stream, size_t length, long baud) {
+    static const uint8_t command[] = "\rload\r";
+    uint8_t header[12];
+    put_le32(header, (uint32_t)length);
+    put_le32(header + 4, crc32(image, length));
+    put_le32(header + 8, (uint32_t)baud_divisor(baud));
+
+    if (stream) {
+        if (fwrite(command, 1, sizeof(command) - 1, stream) != sizeof(command) - 1 ||
+            fwrite(header, 1, sizeof(header), stream) != sizeof(header) ||
+            fwrite(image, 1, length, image_stream) != length)
+            return -1;
+        return 0;
+    }
+
+    if (write_all(fd, command, sizeof(command) - 1) != 0 || read_reply(fd, "load command", 1) != 0)
+        return -1;
+    if (write_all(fd, header, sizeof(header)) != 0 || read_reply(fd, "header", 0) != 0)
+        return -1;
+    if (baud != CONSOLE_BAUD && set_baud(fd, baud) != 0)
+        return -1;
+    for (size_t offset = 0; offset < length; offset += LOAD_CHUNK) {
+        size_t chunk = length - offset < LOAD_CHUNK ? length - offset : LOAD_CHUNK;
+        if (write_all(fd, image + offset, chunk) != 0 || read_reply(fd, "image chunk", 0) != 0)
+            return -1;
+        fprintf(stderr, "\r%zu / %zu bytes", offset + chunk, length);
+    }
+    fprintf(stderr, "\n");
+    return read_reply(fd, "image CRC-32", 0);
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s [-b baud] <serial port> <image.bin>\n"
+            "       %s [-b baud] --stream <output> [--stream-image <output>] <image.bin>\n"
+            "  -b baud              image transfer baud rate (default 115200); the loader\n"
+            "                       is started at 115200 and switches after the header\n"
+            "  --stream FILE        write the bytes sent to the device to FILE without\n"
+            "                       waiting for replies, e.g. for target/top_sim --rx\n"
+            "  --stream-image FILE  write the image to FILE instead, to be sent after\n"
+            "                       --rx-wait '\\x06\\x06' when -b changes the rate\n",
+            program, program);
+}
+
+int main(int argc, char* argv[]) {
+    long baud = CONSOLE_BAUD;
+    const char* stream_path = NULL;
+    const char* image_stream_path = NULL;
+    int arg = 1;
+    for (; arg + 1 < argc; arg += 2) {
+        if (strcmp(argv[arg], "-b") == 0)
+            baud = strtol(argv[arg + 1], NULL, 10);
+        else if (strcmp(argv[arg], "--stream") == 0)
+            stream_path = argv[arg + 1];
+        else if (strcmp(argv[arg], "--stream-image") == 0)
+            image_stream_path = argv[arg + 1];
+        else
+            break;
+    }
+    if (argc - arg != (stream_path ? 1 : 2) || (image_stream_path && !stream_path)) {
+        usage(argv[0]);
+        return 1;
+    }
+    // uart.v takes divisors of 2 to 0xFFFF
+    if (baud <= 0 || baud_divisor(baud) < 2 || baud_divisor(baud) > 0xFFFF ||
+        (!stream_path && baud_to_speed(baud) == 0)) {
+        fprintf(stderr, "Unsupported baud rate: %ld\n", baud);
+        return 1;
+    }
+    const char* image_path = argv[argc - 1];
+
+    FILE* fin = fopen(image_path, "rb");
+    if (!fin) {
+        fprintf(stderr, "Cannot open image: %s\n", image_path);
+        return 1;
+    }
+    size_t length = fread(image, 1, sizeof(image), fin);
+    int too_large = fgetc(fin) != EOF;
+    fclose(fin);
+    if (length == 0 || too_large) {
+        fprintf(stderr, "Image must be 1 to %d bytes: %s\n", LOAD_MAX, image_path);
+        return 1;
+    }
+
+    int result;
+    if (stream_path) {
+        FILE* fout = fopen(stream_path, "wb");
+        FILE* fimage = image_stream_path ? fopen(image_stream_path, "wb") : fout;
+        if (!fout || !fimage) {
+            fprintf(stderr, "Cannot open output file: %s\n", !fout ? stream_path : image_stream_path);
+            if (fout)
+                fclose(fout);
+            return 1;
+        }
+        result = send_image(-1, fout, fimage, length, baud);
+        if (fclose(fout) != 0 || (fimage != fout && fclose(fimage) != 0))
+            result = -1;
+        if (result != 0)
+            fprintf(stderr, "Cannot write output file: %s\n", stream_path);
+    } else {
+        int fd = open_port(argv[arg]);
+        if (fd < 0)
+            return 1;
+        result = send_image(fd, NULL, NULL, length, baud);
+        close(fd);
+        if (result == 0)
+            fprintf(stderr, "Image running\n");
+    }
+    return result == 0 ? 0 : 1;
+}
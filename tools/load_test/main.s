@@ -0,0 +1,41 @@
+; Copyright (c) 2026 Bastiaan van der Plaat
+; SPDX-License-Identifier: MIT
+
+; Test image for the UART loader, assembled to run at LOAD_ADDR. It prints a
+; line by polling the UART directly, since the loader starts it with
+; interrupts disabled. The absolute %hi/%lo address checks the -b base. The
+; line is first copied byte by byte to the PSRAM, across two cache lines,
+; and printed from there.
+
+.include "../../boot/consts.s"
+
+_start:
+    lui s0, %hi(str_loaded)
+    addi s0, s0, %lo(str_loaded)
+    li s2, PSRAM_BASE
+    addi s2, s2, 0x7F0
+copy_loop:
+    lbu t0, 0(s0)
+    sb t0, 0(s2)
+    addi s0, s0, 1
+    addi s2, s2, 1
+    bne t0, zero, copy_loop
+
+    li s0, PSRAM_BASE
+    addi s0, s0, 0x7F0
+    li s1, UART_TX_DATA
+print_loop:
+    lbu a0, 0(s0)
+    beq a0, zero, done
+wait_tx:
+    lw t0, 4(s1)               ; TX status: bit 0 FIFO full
+    andi t0, t0, 1
+    bne t0, zero, wait_tx
+    sb a0, 0(s1)
+    addi s0, s0, 1
+    j print_loop
+done:
+    j done
+
+str_loaded:
+    .asciz "Loaded image running\r\n"
@@ -0,0 +1,224 @@
+; Copyright (c) 2026 Bastiaan van der Plaat
+; SPDX-License-Identifier: MIT
+
+; RV32M test ROM, run on both CPU cores by make test. Every case computes one
+; multiply or divide with its result checked by the very next instruction, so
+; on the pipelined core each one also exercises the forwarding from the
+; multiplier and divider. s0 counts the cases for tools/test_report.s.
+
+.include "../../boot/consts.s"
+
+_start:
+    addi s0, zero, 0
+
+    ; Multiply
+    addi s0, s0, 1
+    li a0, 7
+    li a1, -3
+    li a3, -21
+    mul a2, a0, a1
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a0, 0x12345678
+    li a1, 0x9ABCDEF0
+    li a3, 0x242D2080
+    mul a2, a0, a1
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a0, 0x80000000
+    li a1, 0x80000000
+    li a3, 0x40000000
+    mulh a2, a0, a1
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a0, -1
+    li a1, -1
+    li a3, 0
+    mulh a2, a0, a1
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a0, 0x7FFFFFFF
+    li a1, -2
+    li a3, -1
+    mulh a2, a0, a1
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a0, -1
+    li a1, -1
+    li a3, -1
+    mulhsu a2, a0, a1
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a0, 0x80000000
+    li a1, -1
+    li a3, 0x80000000
+    mulhsu a2, a0, a1
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a0, 0x7FFFFFFF
+    li a1, 0x80000000
+    li a3, 0x3FFFFFFF
+    mulhsu a2, a0, a1
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a0, -1
+    li a1, -1
+    li a3, -2
+    mulhu a2, a0, a1
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a0, 0x12345678
+    li a1, 0x9ABCDEF0
+    li a3, 0x0B00EA4E
+    mulhu a2, a0, a1
+    bne a2, a3, fail
+
+    ; Signed division rounds towards zero and the remainder takes the sign of
+    ; the dividend
+    addi s0, s0, 1
+    li a0, -7
+    li a1, 2
+    li a3, -3
+    div a2, a0, a1
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a0, 7
+    li a1, -2
+    li a3, -3
+    div a2, a0, a1
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a0, -7
+    li a1, -2
+    li a3, 3
+    div a2, a0, a1
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a0, -7
+    li a1, 2
+    li a3, -1
+    rem a2, a0, a1
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a0, 7
+    li a1, -2
+    li a3, 1
+    rem a2, a0, a1
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a0, -7
+    li a1, -2
+    li a3, -1
+    rem a2, a0, a1
+    bne a2, a3, fail
+
+    ; Unsigned division
+    addi s0, s0, 1
+    li a0, -1
+    li a1, 3
+    li a3, 0x55555555
+    divu a2, a0, a1
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a0, -1
+    li a1, 7
+    li a3, 3
+    remu a2, a0, a1
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a0, 0x80000000
+    li a1, -1
+    li a3, 0
+    divu a2, a0, a1
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a0, 0x000F4240
+    li a1, 1000
+    li a3, 1000
+    divu a2, a0, a1
+    bne a2, a3, fail
+
+    ; Division by zero gives all ones and leaves the dividend as remainder
+    addi s0, s0, 1
+    li a0, 1234
+    li a1, 0
+    li a3, -1
+    div a2, a0, a1
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a0, 1234
+    li a1, 0
+    li a3, -1
+    divu a2, a0, a1
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a0, -1234
+    li a1, 0
+    li a3, -1234
+    rem a2, a0, a1
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a0, -2
+    li a1, 0
+    li a3, -2
+    remu a2, a0, a1
+    bne a2, a3, fail
+
+    ; INT_MIN / -1 overflows to INT_MIN with remainder 0
+    addi s0, s0, 1
+    li a0, 0x80000000
+    li a1, -1
+    li a3, 0x80000000
+    div a2, a0, a1
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a0, 0x80000000
+    li a1, -1
+    li a3, 0
+    rem a2, a0, a1
+    bne a2, a3, fail
+
+    ; Results consumed straight away by another divide, the multiplier, an
+    ; ALU op and a store, and a divide that overwrites its own source
+    addi s0, s0, 1
+    li a0, -100
+    li a1, 7
+    addi t0, zero, 3
+    li a3, -2
+    div a2, a0, a1             ; -14
+    rem a2, a2, t0
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a3, 196
+    div a2, a0, a1
+    mul a2, a2, a2
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a3, 0x24924917          ; 0xFFFFFF9C / 7 + 1
+    divu a2, a0, a1
+    addi a2, a2, 1
+    bne a2, a3, fail
+    addi s0, s0, 1
+    li a3, -14
+    lui sp, %hi(STACK_TOP)
+    div a2, a0, a1
+    sw a2, -4(sp)
+    lw a4, -4(sp)
+    bne a4, a3, fail
+    addi s0, s0, 1
+    li a3, -2
+    div a0, a0, a1
+    div a0, a0, a1
+    bne a0, a3, fail
+
+    la a1, str_name
+    j test_pass
+
+fail:
+    la a1, str_name
+    j test_fail
+
+.include "../test_report.s"
+
+str_name:
+    .asciz "M test"
@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Host simulator of the Zaheer SoC: runs a ROM image on the sim_core.h
+// interpreter with the fpga/top.v memory map. ROM, RAM and, with --psram, the
+// PSRAM are host memory aliased over their address regions like the partial
+// decoding in top.v; the UART, LEDs, timer and Taro are sim_devices.h plug-ins. Takes
+// the same UART and frame options as the Verilator harness, but runs one
+// instruction per cycle, so the cycle counts are not those of either core.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "sim_core.h"
+#include "sim_devices.h"
+#include "sim_line.h"
+#include "taro.h"
+
+#define REGION_SIZE 0x10000000u  // top.v decodes the top address nibble
+#define ROM_BASE 0x00000000u
+#define ROM_SIZE 0x1000u
+#define PSRAM_BASE 0x10000000u
+#define PSRAM_SIZE 0x800000u
+#define RAM_BASE 0x20000000u
+#define RAM_SIZE 0x4000u
+#define UART_BASE 0x40000000u
+#define LED_BASE 0x60000000u
+#define VIDEO_BASE 0x80000000u
+#define TIMER_BASE 0xA0000000u
+
+static Sim sim;
+static Taro taro;
+static SimUart uart;
+static SimTimer timer;
+static SimLed led;
+static SimTaro video;
+
+static uint8_t rom[ROM_SIZE];
+static uint8_t ram[RAM_SIZE];
+static uint8_t psram[PSRAM_SIZE];
+
+static SimLine line;
+
+static void tx_byte(Sim* sim, void* context, uint8_t byte) {
+    (void)context;
+    if (sim_line_tx(&line, byte))
+        sim->stop = 1;
+    sim_uart_release_rx(&uart, sim, sim_line_rx_released(&line));
+}
+
+// ROM image in hex words, like $readmemh
+static int load_rom(const char* path) {
+    static uint32_t words[ROM_SIZE / 4];
+    if (sim_line_load_hex(path, words, ROM_SIZE / 4) != 0)
+        return -1;
+    for (uint32_t addr = 0; addr < ROM_SIZE; addr++)
+        rom[addr] = (uint8_t)(words[addr / 4] >> (addr % 4 * 8));
+    return 0;
+}
+
+static void usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --rom FILE         boot from the hex words in FILE (default target/boot.mem)\n" SIM_LINE_USAGE
+            "  --cycles N         stop after N cycles (default 100000000)\n"
+            "  --frame FILE       write the final Taro frame as a PPM image\n"
+            "  --font FILE        Taro font (default fpga/taro/font.pf)\n"
+            "  --psram            map the 8 MB PSRAM like the Verilator model; without it the\n"
+            "                     region reads zero like the bitstream\n",
+            program);
+}
+
+int main(int argc, char* argv[]) {
+    const char* rom_path = "target/boot.mem";
+    const char* frame_path = NULL;
+    const char* font_path = "fpga/taro/font.pf";
+    uint64_t max_cycles = 100000000;
+    int psram_enabled = 0;
+
+    sim_line_init(&line);
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        if (strcmp(arg, "--psram") == 0) {
+            psram_enabled = 1;
+            continue;
+        }
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return 1;
+        }
+        const char* value = argv[++i];
+        int handled = sim_line_option(&line, arg, value);
+        if (handled < 0)
+            return 1;
+        if (handled)
+            continue;
+        if (strcmp(arg, "--rom") == 0) {
+            rom_path = value;
+        } else if (strcmp(arg, "--cycles") == 0) {
+            max_cycles = strtoull(value, NULL, 10);
+        } else if (strcmp(arg, "--frame") == 0) {
+            frame_path = value;
+        } else if (strcmp(arg, "--font") == 0) {
+            font_path = value;
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (load_rom(rom_path) != 0) {
+        fprintf(stderr, "Cannot open ROM file: %s\n", rom_path);
+        return 1;
+    }
+    taro_init(&taro, NULL);
+    if (frame_path && taro_load_font(&taro, font_path) != 0) {
+        fprintf(stderr, "Cannot load 2048-byte font: %s\n", font_path);
+        return 1;
+    }
+
+    sim_init(&sim);
+    sim_map_memory(&sim, ROM_BASE, REGION_SIZE, rom, ROM_SIZE, SIM_READ);
+    if (psram_enabled)
+        sim_map_memory(&sim, PSRAM_BASE, REGION_SIZE, psram, PSRAM_SIZE, SIM_READ | SIM_WRITE);
+    sim_map_memory(&sim, RAM_BASE, REGION_SIZE, ram, RAM_SIZE, SIM_READ | SIM_WRITE);
+
+    sim_uart_init(&uart, SIM_LINE_BAUD_TICKS);
+    uart.tx_byte = tx_byte;
+    sim_timer_init(&timer);
+    sim_led_init(&led);
+    sim_taro_init(&video, &taro);
+    sim_map_device(&sim, UART_BASE, REGION_SIZE, &uart.device);
+    sim_map_device(&sim, LED_BASE, REGION_SIZE, &led.device);
+    sim_map_device(&sim, TIMER_BASE, REGION_SIZE, &timer.device);
+    sim_taro_map(&video, &sim, VIDEO_BASE);
+    sim_uart_set_rx(&uart, &sim, line.rx_bytes, sim_line_rx_released(&line));
+
+    sim_run(&sim, max_cycles);
+
+    int unmatched = sim_line_finish(&line);
+
+    if (frame_path) {
+        taro_render(&taro);
+        FILE* frame_file = fopen(frame_path, "wb");
+        if (!frame_file || taro_write_ppm(&taro, frame_file) != 0) {
+            fprintf(stderr, "Cannot write frame file: %s\n", frame_path);
+            return 1;
+        }
+        fclose(frame_file);
+    }
+
+    fprintf(stderr, "sim: %llu cycles, %llu instructions%s\n", (unsigned long long)sim.cycle,
+            (unsigned long long)sim.minstret, sim.halted ? ", halted in wfi" : "");
+    if (unmatched) {
+        fprintf(stderr, "sim: UART output did not reach the expected text\n");
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,618 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// RV32IMC interpreter and page-table memory for the host simulator, see
+// sim_core.h. Decoding follows fpga/cpu.v: misaligned loads and stores use
+// the aligned word with the same byte lanes, and traps, MRET and WFI behave
+// like cpu_csr.v.
+
+#include "sim_core.h"
+
+#include <string.h>
+
+#define OP_LOAD 0x03
+#define OP_FENCE 0x0F
+#define OP_IMM 0x13
+#define OP_AUIPC 0x17
+#define OP_STORE 0x23
+#define OP_REG 0x33
+#define OP_LUI 0x37
+#define OP_BRANCH 0x63
+#define OP_JALR 0x67
+#define OP_JAL 0x6F
+#define OP_SYSTEM 0x73
+
+#define CSR_MSTATUS 0x300
+#define CSR_MIE 0x304
+#define CSR_MTVEC 0x305
+#define CSR_MSCRATCH 0x340
+#define CSR_MEPC 0x341
+#define CSR_MCAUSE 0x342
+#define CSR_MIP 0x344
+
+#define MSTATUS_MIE (1u << 3)
+#define MSTATUS_MPIE (1u << 7)
+#define MSTATUS_MPP (3u << 11)  // always machine mode
+
+#define CAUSE_ILLEGAL 2
+#define CAUSE_BREAKPOINT 3
+#define CAUSE_ECALL 11
+#define CAUSE_TIMER 0x80000007u
+#define CAUSE_EXTERNAL 0x8000000Bu
+
+// Counter CSRs: 0xB00 + n machine, 0xC00 + n user, bit 7 the high half
+#define COUNTER_CYCLE 0
+#define COUNTER_INSTRET 2
+#define COUNTER_HPM 3
+#define HPM_STORES 1
+#define HPM_BRANCHES 2
+
+void sim_init(Sim* sim) {
+    memset(sim, 0, sizeof(*sim));
+    sim->next_event = SIM_NEVER;
+    sim->end_cycle = SIM_NEVER;
+}
+
+void sim_map_memory(Sim* sim, uint32_t base, uint32_t size, uint8_t* host, uint32_t host_size, int flags) {
+    for (uint32_t offset = 0; offset < size; offset += SIM_PAGE_SIZE) {
+        SimPage* page = &sim->pages[(base + offset) >> SIM_PAGE_BITS];
+        uint8_t* data = host + offset % host_size;
+        if (flags & SIM_READ)
+            page->read = data;
+        if (flags & SIM_WRITE)
+            page->write = data;
+    }
+}
+
+int sim_map_device(Sim* sim, uint32_t base, uint32_t size, SimDevice* device) {
+    int known = 0;
+    for (int i = 0; i < sim->device_count; i++) {
+        if (sim->devices[i] == device)
+            known = 1;
+    }
+    if (!known) {
+        if (sim->device_count == SIM_MAX_DEVICES)
+            return -1;
+        sim->devices[sim->device_count++] = device;
+    }
+    for (uint32_t offset = 0; offset < size; offset += SIM_PAGE_SIZE)
+        sim->pages[(base + offset) >> SIM_PAGE_BITS].device = device;
+    sim_update_events(sim);
+    return 0;
+}
+
+void sim_set_irq(Sim* sim, uint32_t line, int level) {
+    if (level)
+        sim->mip |= line;
+    else
+        sim->mip &= ~line;
+}
+
+void sim_update_events(Sim* sim) {
+    uint64_t next = SIM_NEVER;
+    for (int i = 0; i < sim->device_count; i++) {
+        SimDevice* device = sim->devices[i];
+        if (device->event && device->event_cycle < next)
+            next = device->event_cycle;
+    }
+    sim->next_event = next;
+}
+
+// === Memory ===
+
+static uint32_t device_read(Sim* sim, SimDevice* device, uint32_t addr) {
+    if (!device || !device->read)
+        return 0;
+    uint32_t value = device->read(sim, device, addr);
+    sim_update_events(sim);
+    return value;
+}
+
+static inline uint32_t load_word(Sim* sim, uint32_t addr) {
+    const SimPage* page = &sim->pages[addr >> SIM_PAGE_BITS];
+    if (page->read) {
+        uint32_t value;
+        memcpy(&value, page->read + (addr & SIM_PAGE_MASK & ~3u), 4);
+        return value;
+    }
+    return device_read(sim, page->device, addr & ~3u);
+}
+
+static inline void store_word(Sim* sim, uint32_t addr, uint32_t wdata, uint32_t wstrb) {
+    SimPage* page = &sim->pages[addr >> SIM_PAGE_BITS];
+    if (page->write) {
+        uint8_t* dest = page->write + (addr & SIM_PAGE_MASK & ~3u);
+        if (wstrb == 0xF) {
+            memcpy(dest, &wdata, 4);
+        } else {
+            for (int lane = 0; lane < 4; lane++) {
+                if (wstrb & (1u << lane))
+                    dest[lane] = (uint8_t)(wdata >> (lane * 8));
+            }
+        }
+        return;
+    }
+    SimDevice* device = page->device;
+    if (device && device->write) {
+        device->write(sim, device, addr & ~3u, wdata, wstrb);
+        sim_update_events(sim);
+    }
+}
+
+uint32_t sim_read(Sim* sim, uint32_t addr) {
+    return load_word(sim, addr);
+}
+
+void sim_write(Sim* sim, uint32_t addr, uint32_t wdata, uint32_t wstrb) {
+    store_word(sim, addr, wdata, wstrb);
+}
+
+// Fetch 32 bits at pc, or just the 16-bit parcel when it is compressed
+static inline uint32_t fetch(Sim* sim, uint32_t pc) {
+    const uint8_t* page = sim->pages[pc >> SIM_PAGE_BITS].read;
+    uint32_t offset = pc & SIM_PAGE_MASK;
+    if (page && offset <= SIM_PAGE_SIZE - 4) {
+        uint32_t instr;
+        memcpy(&instr, page + offset, 4);
+        return instr;
+    }
+    uint32_t low = (load_word(sim, pc) >> ((pc & 2) * 8)) & 0xFFFF;
+    if ((low & 3) != 3)
+        return low;
+    return low | ((load_word(sim, pc + 2) << ((pc & 2) ? 16 : 0)) & 0xFFFF0000u);
+}
+
+// === RVC expansion (see fpga/cpu_rvc.v) ===
+
+#define BITS(value, high, low) (((value) >> (low)) & ((1u << ((high) - (low) + 1)) - 1))
+#define BIT(value, n) (((value) >> (n)) & 1)
+
+static uint32_t sign_extend(uint32_t value, int bits) {
+    return (uint32_t)((int32_t)(value << (32 - bits)) >> (32 - bits));
+}
+
+static uint32_t i_type(uint32_t imm, uint32_t rs1, uint32_t funct3, uint32_t rd, uint32_t opcode) {
+    return (imm & 0xFFF) << 20 | rs1 << 15 | funct3 << 12 | rd << 7 | opcode;
+}
+
+static uint32_t s_type(uint32_t imm, uint32_t rs2, uint32_t rs1, uint32_t funct3) {
+    return BITS(imm, 11, 5) << 25 | rs2 << 20 | rs1 << 15 | funct3 << 12 | BITS(imm, 4, 0) << 7 | OP_STORE;
+}
+
+static uint32_t r_type(uint32_t funct7, uint32_t rs2, uint32_t rs1, uint32_t funct3, uint32_t rd) {
+    return funct7 << 25 | rs2 << 20 | rs1 << 15 | funct3 << 12 | rd << 7 | OP_REG;
+}
+
+static uint32_t b_type(uint32_t imm, uint32_t rs1, uint32_t funct3) {
+    return BIT(imm, 12) << 31 | BITS(imm, 10, 5) << 25 | rs1 << 15 | funct3 << 12 | BITS(imm, 4, 1) << 8 |
+           BIT(imm, 11) << 7 | OP_BRANCH;
+}
+
+static uint32_t j_type(uint32_t imm, uint32_t rd) {
+    return BIT(imm, 20) << 31 | BITS(imm, 10, 1) << 21 | BIT(imm, 11) << 20 | BITS(imm, 19, 12) << 12 | rd << 7 |
+           OP_JAL;
+}
+
+// Returns the 32-bit equivalent of a compressed instruction, or 0 if illegal
+static uint32_t expand(uint32_t c) {
+    uint32_t rd = BITS(c, 11, 7), rs2 = BITS(c, 6, 2);
+    uint32_t rd_prime = 8 + BITS(c, 4, 2), rs1_prime = 8 + BITS(c, 9, 7);
+    uint32_t imm6 = sign_extend(BIT(c, 12) << 5 | BITS(c, 6, 2), 6);
+    uint32_t shamt = BITS(c, 6, 2);
+
+    switch (BITS(c, 1, 0) << 3 | BITS(c, 15, 13)) {
+        case 000: {  // C.ADDI4SPN
+            uint32_t imm = BITS(c, 10, 7) << 6 | BITS(c, 12, 11) << 4 | BIT(c, 5) << 3 | BIT(c, 6) << 2;
+            return imm ? i_type(imm, 2, 0, rd_prime, OP_IMM) : 0;
+        }
+        case 002: {  // C.LW
+            uint32_t imm = BIT(c, 5) << 6 | BITS(c, 12, 10) << 3 | BIT(c, 6) << 2;
+            return i_type(imm, rs1_prime, 2, rd_prime, OP_LOAD);
+        }
+        case 006: {  // C.SW
+            uint32_t imm = BIT(c, 5) << 6 | BITS(c, 12, 10) << 3 | BIT(c, 6) << 2;
+            return s_type(imm, rd_prime, rs1_prime, 2);
+        }
+        case 010:  // C.ADDI
+            return i_type(imm6, rd, 0, rd, OP_IMM);
+        case 011:  // C.JAL
+        case 015: {  // C.J
+            uint32_t imm = sign_extend(BIT(c, 12) << 11 | BIT(c, 8) << 10 | BITS(c, 10, 9) << 8 | BIT(c, 6) << 7 |
+                                           BIT(c, 7) << 6 | BIT(c, 2) << 5 | BIT(c, 11) << 4 | BITS(c, 5, 3) << 1,
+                                       12);
+            return j_type(imm, BITS(c, 15, 13) == 1 ? 1 : 0);
+        }
+        case 012:  // C.LI
+            return i_type(imm6, 0, 0, rd, OP_IMM);
+        case 013:
+            if (rd == 2) {  // C.ADDI16SP
+                uint32_t imm = sign_extend(
+                    BIT(c, 12) << 9 | BITS(c, 4, 3) << 7 | BIT(c, 5) << 6 | BIT(c, 2) << 5 | BIT(c, 6) << 4, 10);
+                return imm ? i_type(imm, 2, 0, 2, OP_IMM) : 0;
+            }
+            return imm6 ? (imm6 << 12) | rd << 7 | OP_LUI : 0;  // C.LUI
+        case 014:
+            switch (BITS(c, 11, 10)) {
+                case 0:  // C.SRLI
+                    return BIT(c, 12) ? 0 : i_type(shamt, rs1_prime, 5, rs1_prime, OP_IMM);
+                case 1:  // C.SRAI
+                    return BIT(c, 12) ? 0 : i_type(0x400 | shamt, rs1_prime, 5, rs1_prime, OP_IMM);
+                case 2:  // C.ANDI
+                    return i_type(imm6, rs1_prime, 7, rs1_prime, OP_IMM);
+                default: {  // C.SUB, C.XOR, C.OR, C.AND
+                    static const uint32_t funct3[4] = {0, 4, 6, 7};
+                    if (BIT(c, 12))
+                        return 0;
+                    return r_type(BITS(c, 6, 5) == 0 ? 0x20 : 0, rd_prime, rs1_prime, funct3[BITS(c, 6, 5)],
+                                  rs1_prime);
+                }
+            }
+        case 016:  // C.BEQZ
+        case 017: {  // C.BNEZ
+            uint32_t imm = sign_extend(
+                BIT(c, 12) << 8 | BITS(c, 6, 5) << 6 | BIT(c, 2) << 5 | BITS(c, 11, 10) << 3 | BITS(c, 4, 3) << 1, 9);
+            return b_type(imm, rs1_prime, BIT(c, 13));
+        }
+        case 020:  // C.SLLI
+            return BIT(c, 12) ? 0 : i_type(shamt, rd, 1, rd, OP_IMM);
+        case 022: {  // C.LWSP
+            uint32_t imm = BITS(c, 3, 2) << 6 | BIT(c, 12) << 5 | BITS(c, 6, 4) << 2;
+            return rd ? i_type(imm, 2, 2, rd, OP_LOAD) : 0;
+        }
+        case 024:
+            if (!BIT(c, 12)) {
+                if (rs2 == 0)  // C.JR
+                    return rd ? i_type(0, rd, 0, 0, OP_JALR) : 0;
+                return r_type(0, rs2, 0, 0, rd);  // C.MV
+            }
+            if (rd == 0 && rs2 == 0)  // C.EBREAK
+                return 0x00100073;
+            if (rs2 == 0)  // C.JALR
+                return i_type(0, rd, 0, 1, OP_JALR);
+            return r_type(0, rs2, rd, 0, rd);  // C.ADD
+        case 026: {  // C.SWSP
+            uint32_t imm = BITS(c, 8, 7) << 6 | BITS(c, 12, 9) << 2;
+            return s_type(imm, rs2, 2, 2);
+        }
+    }
+    return 0;
+}
+
+// === CSRs and traps ===
+
+static int is_counter(uint32_t addr) {
+    return ((addr >> 8) == 0xB || (addr >> 8) == 0xC) && (addr & 0x60) == 0;
+}
+
+static uint64_t* counter_ref(Sim* sim, uint32_t index) {
+    if (index == COUNTER_INSTRET)
+        return &sim->minstret;
+    if (index >= COUNTER_HPM && index < COUNTER_HPM + SIM_HPM_COUNTERS)
+        return &sim->mhpmcounter[index - COUNTER_HPM];
+    return NULL;
+}
+
+static uint32_t csr_read(Sim* sim, uint32_t addr) {
+    switch (addr) {
+        case CSR_MSTATUS:
+            return sim->mstatus | MSTATUS_MPP;
+        case CSR_MIE:
+            return sim->mie;
+        case CSR_MTVEC:
+            return sim->mtvec;
+        case CSR_MSCRATCH:
+            return sim->mscratch;
+        case CSR_MEPC:
+            return sim->mepc;
+        case CSR_MCAUSE:
+            return sim->mcause;
+        case CSR_MIP:
+            return sim->mip;
+    }
+    if (!is_counter(addr))
+        return 0;
+    uint32_t index = addr & 0x1F;
+    uint64_t* ref = counter_ref(sim, index);
+    uint64_t counter = index == COUNTER_CYCLE ? sim->cycle - sim->mcycle_base : ref ? *ref : 0;
+    return (addr & 0x80) ? (uint32_t)(counter >> 32) : (uint32_t)counter;
+}
+
+static void csr_write(Sim* sim, uint32_t addr, uint32_t value) {
+    switch (addr) {
+        case CSR_MSTATUS:
+            sim->mstatus = value & (MSTATUS_MIE | MSTATUS_MPIE);
+            return;
+        case CSR_MIE:
+            sim->mie = value & (SIM_IRQ_TIMER | SIM_IRQ_EXTERNAL);
+            return;
+        case CSR_MTVEC:
+            sim->mtvec = value & ~3u;
+            return;
+        case CSR_MSCRATCH:
+            sim->mscratch = value;
+            return;
+        case CSR_MEPC:
+            sim->mepc = value & ~1u;
+            return;
+        case CSR_MCAUSE:
+            sim->mcause = value;
+            return;
+    }
+    if ((addr >> 8) != 0xB || !is_counter(addr))
+        return;
+
+    // A counter write replaces the increment that this instruction makes
+    uint32_t index = addr & 0x1F;
+    uint64_t* ref = counter_ref(sim, index);
+    uint64_t old = index == COUNTER_CYCLE ? sim->cycle - sim->mcycle_base : ref ? *ref : 0;
+    uint64_t counter = (addr & 0x80) ? (old & 0xFFFFFFFFu) | (uint64_t)value << 32
+                                     : (old & ~(uint64_t)0xFFFFFFFFu) | value;
+    if (index == COUNTER_CYCLE)
+        sim->mcycle_base = sim->cycle + 1 - counter;
+    else if (index == COUNTER_INSTRET)
+        sim->minstret = counter - 1;
+    else if (ref)
+        *ref = counter;
+}
+
+static void trap(Sim* sim, uint32_t cause) {
+    sim->mepc = sim->pc;
+    sim->mcause = cause;
+    sim->mstatus = (sim->mstatus & MSTATUS_MIE) ? MSTATUS_MPIE : 0;
+    sim->pc = sim->mtvec;
+    sim->cycle++;
+}
+
+// === Execution ===
+
+static uint32_t alu(uint32_t funct3, int alternate, uint32_t a, uint32_t b) {
+    switch (funct3) {
+        case 0:
+            return alternate ? a - b : a + b;
+        case 1:
+            return a << (b & 31);
+        case 2:
+            return (int32_t)a < (int32_t)b;
+        case 3:
+            return a < b;
+        case 4:
+            return a ^ b;
+        case 5:
+            return alternate ? (uint32_t)((int32_t)a >> (b & 31)) : a >> (b & 31);
+        case 6:
+            return a | b;
+        default:
+            return a & b;
+    }
+}
+
+static uint32_t muldiv(uint32_t funct3, uint32_t a, uint32_t b) {
+    int32_t sa = (int32_t)a, sb = (int32_t)b;
+    switch (funct3) {
+        case 0:  // MUL
+            return a * b;
+        case 1:  // MULH
+            return (uint32_t)((uint64_t)((int64_t)sa * sb) >> 32);
+        case 2:  // MULHSU
+            return (uint32_t)((uint64_t)((int64_t)sa * (int64_t)b) >> 32);
+        case 3:  // MULHU
+            return (uint32_t)(((uint64_t)a * b) >> 32);
+        case 4:  // DIV
+            if (b == 0)
+                return 0xFFFFFFFF;
+            if (a == 0x80000000 && b == 0xFFFFFFFF)
+                return a;
+            return (uint32_t)(sa / sb);
+        case 5:  // DIVU
+            return b == 0 ? 0xFFFFFFFF : a / b;
+        case 6:  // REM
+            if (b == 0)
+                return a;
+            if (a == 0x80000000 && b == 0xFFFFFFFF)
+                return 0;
+            return (uint32_t)(sa % sb);
+        default:  // REMU
+            return b == 0 ? a : a % b;
+    }
+}
+
+static void step(Sim* sim) {
+    uint32_t pc = sim->pc;
+    uint32_t instr = fetch(sim, pc);
+    uint32_t next_pc = pc + 4;
+    if ((instr & 3) != 3) {
+        instr = expand(instr & 0xFFFF);
+        next_pc = pc + 2;
+        if (!instr) {
+            trap(sim, CAUSE_ILLEGAL);
+            return;
+        }
+    }
+
+    uint32_t* x = sim->regs;
+    uint32_t opcode = instr & 0x7F;
+    uint32_t rd = BITS(instr, 11, 7);
+    uint32_t funct3 = BITS(instr, 14, 12);
+    uint32_t rs1_index = BITS(instr, 19, 15);
+    uint32_t rs1 = x[rs1_index];
+    uint32_t rs2 = x[BITS(instr, 24, 20)];
+    uint32_t imm_i = (uint32_t)((int32_t)instr >> 20);
+    uint32_t result = 0;
+    int write_rd = 1;
+
+    switch (opcode) {
+        case OP_LUI:
+            result = instr & 0xFFFFF000;
+            break;
+        case OP_AUIPC:
+            result = pc + (instr & 0xFFFFF000);
+            break;
+        case OP_JAL:
+            result = next_pc;
+            next_pc = pc + sign_extend(BIT(instr, 31) << 20 | BITS(instr, 19, 12) << 12 | BIT(instr, 20) << 11 |
+                                           BITS(instr, 30, 21) << 1,
+                                       21);
+            break;
+        case OP_JALR:
+            result = next_pc;
+            next_pc = (rs1 + imm_i) & ~1u;
+            break;
+        case OP_BRANCH: {
+            int taken;
+            switch (funct3) {
+                case 0:
+                    taken = rs1 == rs2;
+                    break;
+                case 1:
+                    taken = rs1 != rs2;
+                    break;
+                case 4:
+                    taken = (int32_t)rs1 < (int32_t)rs2;
+                    break;
+                case 5:
+                    taken = (int32_t)rs1 >= (int32_t)rs2;
+                    break;
+                case 6:
+                    taken = rs1 < rs2;
+                    break;
+                case 7:
+                    taken = rs1 >= rs2;
+                    break;
+                default:
+                    taken = 0;
+                    break;
+            }
+            if (taken) {
+                next_pc = pc + sign_extend(BIT(instr, 31) << 12 | BIT(instr, 7) << 11 | BITS(instr, 30, 25) << 5 |
+                                               BITS(instr, 11, 8) << 1,
+                                           13);
+                sim->mhpmcounter[HPM_BRANCHES]++;
+            }
+            write_rd = 0;
+            break;
+        }
+        case OP_LOAD: {
+            uint32_t addr = rs1 + imm_i;
+            uint32_t word = load_word(sim, addr);
+            switch (funct3) {
+                case 0:  // LB
+                    result = sign_extend(word >> ((addr & 3) * 8), 8);
+                    break;
+                case 1:  // LH
+                    result = sign_extend(word >> ((addr & 2) * 8), 16);
+                    break;
+                case 4:  // LBU
+                    result = (word >> ((addr & 3) * 8)) & 0xFF;
+                    break;
+                case 5:  // LHU
+                    result = (word >> ((addr & 2) * 8)) & 0xFFFF;
+                    break;
+                default:  // LW
+                    result = word;
+                    break;
+            }
+            break;
+        }
+        case OP_STORE: {
+            uint32_t addr = rs1 + ((imm_i & ~0x1Fu) | rd);
+            if (funct3 == 0)
+                store_word(sim, addr, (rs2 & 0xFF) * 0x01010101u, 1u << (addr & 3));
+            else if (funct3 == 1)
+                store_word(sim, addr, (rs2 & 0xFFFF) * 0x00010001u, (addr & 2) ? 0xC : 0x3);
+            else
+                store_word(sim, addr, rs2, 0xF);
+            sim->mhpmcounter[HPM_STORES]++;
+            write_rd = 0;
+            break;
+        }
+        case OP_IMM:
+            result = alu(funct3, funct3 == 5 && BIT(instr, 30), rs1, imm_i);
+            break;
+        case OP_REG:
+            if (BITS(instr, 31, 25) == 1)
+                result = muldiv(funct3, rs1, rs2);
+            else
+                result = alu(funct3, BIT(instr, 30), rs1, rs2);
+            break;
+        case OP_FENCE:
+            write_rd = 0;
+            break;
+        case OP_SYSTEM:
+            if (funct3 & 3) {
+                uint32_t addr = instr >> 20;
+                uint32_t src = (funct3 & 4) ? rs1_index : rs1;
+                result = csr_read(sim, addr);
+                // CSRRS/CSRRC with rs1 = x0 (or a zero immediate) only read
+                if ((funct3 & 3) == 1)
+                    csr_write(sim, addr, src);
+                else if (rs1_index != 0)
+                    csr_write(sim, addr, (funct3 & 3) == 2 ? result | src : result & ~src);
+                break;
+            }
+            write_rd = 0;
+            if (instr == 0x00000073) {
+                trap(sim, CAUSE_ECALL);
+                return;
+            } else if (instr == 0x00100073) {
+                trap(sim, CAUSE_BREAKPOINT);
+                return;
+            } else if (instr == 0x30200073) {  // MRET
+                next_pc = sim->mepc;
+                sim->mstatus = MSTATUS_MPIE | ((sim->mstatus & MSTATUS_MPIE) ? MSTATUS_MIE : 0);
+            } else if (instr == 0x10500073) {  // WFI
+                if (!(sim->mie & sim->mip)) {
+                    // Nothing changes until the next device event: skip to it
+                    if (sim->next_event == SIM_NEVER)
+                        sim->halted = 1;
+                    else if (sim->next_event > sim->cycle)
+                        sim->cycle = sim->next_event < sim->end_cycle ? sim->next_event : sim->end_cycle;
+                    return;
+                }
+            } else {
+                trap(sim, CAUSE_ILLEGAL);
+                return;
+            }
+            break;
+        default:
+            trap(sim, CAUSE_ILLEGAL);
+            return;
+    }
+
+    if (write_rd && rd != 0)
+        x[rd] = result;
+    sim->pc = next_pc;
+    sim->cycle++;
+    sim->minstret++;
+}
+
+static void dispatch_events(Sim* sim) {
+    for (int i = 0; i < sim->device_count; i++) {
+        SimDevice* device = sim->devices[i];
+        if (device->event && device->event_cycle <= sim->cycle)
+            device->event(sim, device);
+    }
+    sim_update_events(sim);
+}
+
+void sim_run(Sim* sim, uint64_t end_cycle) {
+    sim->end_cycle = end_cycle;
+    sim->stop = 0;
+    sim->halted = 0;
+    while (sim->cycle < end_cycle && !sim->stop && !sim->halted) {
+        if (sim->cycle >= sim->next_event) {
+            dispatch_events(sim);
+            if (sim->stop)
+                break;
+        }
+        // External interrupts take priority over the timer
+        uint32_t pending = sim->mie & sim->mip;
+        if ((sim->mstatus & MSTATUS_MIE) && pending) {
+            trap(sim, (pending & SIM_IRQ_EXTERNAL) ? CAUSE_EXTERNAL : CAUSE_TIMER);
+            continue;
+        }
+        step(sim);
+    }
+}
@@ -0,0 +1,131 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Host-side model of the Zaheer CPU: an RV32IMC + Zicsr interpreter with the
+// machine-mode CSRs of fpga/cpu_csr.v, running one instruction per cycle.
+//
+// Memory is a table with one entry per 4KB page of the 32-bit address space.
+// An entry holds direct host pointers for loads (and fetches) and for stores,
+// and a device that handles the accesses without a host pointer. Loads and
+// stores to RAM, ROM and the Taro text RAM index the table and touch host
+// memory without any address decoding; only device pages call out. Pages
+// without a pointer or device read as zero and ignore writes, like the
+// unselected regions in top.v. Host memory is accessed as little-endian words,
+// so the host must be little-endian.
+//
+// Devices plug in with a SimDevice: word read and write callbacks, which see
+// the full word-aligned bus address and decode the bits they use like the RTL
+// modules, and an optional event callback for work that happens with time,
+// such as a UART shifting bits or a timer reaching its compare value. The
+// interpreter only looks at devices when it reaches the earliest requested
+// event cycle, so adding devices does not slow down the RAM fast path.
+
+#ifndef SIM_CORE_H
+#define SIM_CORE_H
+
+#include <stdint.h>
+
+#define SIM_PAGE_BITS 12
+#define SIM_PAGE_SIZE (1u << SIM_PAGE_BITS)
+#define SIM_PAGE_MASK (SIM_PAGE_SIZE - 1)
+#define SIM_PAGES (1u << (32 - SIM_PAGE_BITS))
+#define SIM_MAX_DEVICES 16
+#define SIM_NEVER UINT64_MAX
+
+// Access flags for sim_map_memory and sim_map_device
+#define SIM_READ 1
+#define SIM_WRITE 2
+
+// Interrupt lines, at their mip bit positions
+#define SIM_IRQ_TIMER (1u << 7)
+#define SIM_IRQ_EXTERNAL (1u << 11)
+
+#define SIM_HPM_COUNTERS 8
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct Sim Sim;
+typedef struct SimDevice SimDevice;
+
+struct SimDevice {
+    const char* name;
+    void* context;
+    // Word access; addr is word-aligned, wstrb has one bit per byte lane.
+    // Either callback may be NULL for a device that ignores that direction.
+    uint32_t (*read)(Sim* sim, SimDevice* device, uint32_t addr);
+    void (*write)(Sim* sim, SimDevice* device, uint32_t addr, uint32_t wdata, uint32_t wstrb);
+    // Called once sim->cycle reaches event_cycle; the device sets event_cycle
+    // to its next event, or SIM_NEVER. May be NULL for devices without time.
+    void (*event)(Sim* sim, SimDevice* device);
+    uint64_t event_cycle;
+};
+
+typedef struct SimPage {
+    uint8_t* read;      // host memory for loads and fetches, or NULL
+    uint8_t* write;     // host memory for stores, or NULL
+    SimDevice* device;  // accesses without host memory, or NULL
+} SimPage;
+
+struct Sim {
+    uint32_t regs[32];
+    uint32_t pc;
+    uint64_t cycle;       // device time; one cycle per instruction or trap
+    uint64_t next_event;  // earliest event_cycle of all devices
+    uint64_t end_cycle;   // sim_run stops here
+    int stop;             // set by devices to end sim_run early
+    int halted;           // wfi with no interrupt that could ever wake it
+
+    // Machine-mode CSRs
+    uint32_t mstatus;  // MIE and MPIE only
+    uint32_t mie;      // MTIE and MEIE only
+    uint32_t mip;      // interrupt lines, driven by sim_set_irq
+    uint32_t mtvec;
+    uint32_t mscratch;
+    uint32_t mepc;
+    uint32_t mcause;
+    uint64_t mcycle_base;  // mcycle is cycle - mcycle_base
+    uint64_t minstret;
+    uint64_t mhpmcounter[SIM_HPM_COUNTERS];  // 4 stores, 5 taken branches
+
+    SimDevice* devices[SIM_MAX_DEVICES];
+    int device_count;
+    SimPage pages[SIM_PAGES];
+};
+
+// Reset the CPU and unmap every page. Sim is large (the page table), so it
+// should be static or heap allocated.
+void sim_init(Sim* sim);
+
+// Map [base, base + size) to host memory, repeating host every host_size
+// bytes like a partially decoded address. base, size and host_size must be
+// page multiples. flags selects direct loads, stores or both.
+void sim_map_memory(Sim* sim, uint32_t base, uint32_t size, uint8_t* host, uint32_t host_size, int flags);
+
+// Route the accesses in [base, base + size) that have no host memory to
+// device. Returns -1 when there are too many devices.
+int sim_map_device(Sim* sim, uint32_t base, uint32_t size, SimDevice* device);
+
+// Raise or lower an interrupt line (SIM_IRQ_TIMER or SIM_IRQ_EXTERNAL)
+void sim_set_irq(Sim* sim, uint32_t line, int level);
+
+// Recompute next_event after a device changed its event_cycle outside its
+// own callbacks
+void sim_update_events(Sim* sim);
+
+// Bus accesses as the CPU makes them, for devices and host tools
+uint32_t sim_read(Sim* sim, uint32_t addr);
+void sim_write(Sim* sim, uint32_t addr, uint32_t wdata, uint32_t wstrb);
+
+// Execute until end_cycle, until a device sets stop, or until the CPU halts
+void sim_run(Sim* sim, uint64_t end_cycle);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -0,0 +1,255 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Host simulator device plug-ins, see sim_devices.h
+
+#include "sim_devices.h"
+
+#include <string.h>
+
+#define UART_TX_BITS 10  // start, 8 data, stop
+#define UART_RX_BITS 11  // the RX line idles one bit between bytes
+#define TARO_WINDOW 0x4000
+
+// === UART ===
+
+static int uart_rx_at_threshold(const SimUart* uart) {
+    return uart->rx_level > 0 && uart->rx_level >= uart->rx_threshold;
+}
+
+// Level interrupt and next event after any change of the UART state
+static void uart_update(Sim* sim, SimUart* uart) {
+    int irq = ((uart->irq_enable & 1) && uart_rx_at_threshold(uart)) ||
+              ((uart->irq_enable & 2) && uart->tx_level <= uart->tx_threshold);
+    sim_set_irq(sim, SIM_IRQ_EXTERNAL, irq);
+    uint64_t next = uart->tx_shifting ? uart->tx_done_cycle : SIM_NEVER;
+    if (uart->rx_next_cycle < next)
+        next = uart->rx_next_cycle;
+    uart->device.event_cycle = next;
+}
+
+static void uart_tx_start(Sim* sim, SimUart* uart) {
+    if (uart->tx_shifting || uart->tx_level == 0)
+        return;
+    uart->tx_shift = uart->tx_fifo[uart->tx_head];
+    uart->tx_head = (uart->tx_head + 1) % SIM_UART_FIFO_DEPTH;
+    uart->tx_level--;
+    uart->tx_shifting = 1;
+    uart->tx_done_cycle = sim->cycle + UART_TX_BITS * (uint64_t)uart->divisor;
+}
+
+static void uart_rx_schedule(Sim* sim, SimUart* uart) {
+    if (uart->rx_next_cycle == SIM_NEVER && uart->rx_index < uart->rx_length &&
+        uart->rx_level < SIM_UART_FIFO_DEPTH)
+        uart->rx_next_cycle = sim->cycle + UART_RX_BITS * (uint64_t)uart->divisor;
+}
+
+static uint32_t uart_read(Sim* sim, SimDevice* device, uint32_t addr) {
+    SimUart* uart = device->context;
+    switch ((addr >> 2) & 7) {
+        case 1:
+            return (uart->tx_level <= uart->tx_threshold) << 2 | (uart->tx_shifting || uart->tx_level > 0) << 1 |
+                   (uart->tx_level == SIM_UART_FIFO_DEPTH);
+        case 2:
+            return uart_rx_at_threshold(uart) << 3 | (uart->rx_level > 0);
+        case 3: {
+            if (uart->rx_level == 0)
+                return 0;
+            uint32_t value = uart->rx_fifo[uart->rx_head];
+            uart->rx_head = (uart->rx_head + 1) % SIM_UART_FIFO_DEPTH;
+            uart->rx_level--;
+            uart_rx_schedule(sim, uart);
+            uart_update(sim, uart);
+            return value;
+        }
+        case 4:
+            return uart->irq_enable;
+        case 5:
+            return uart->divisor;
+        case 6:
+            return uart->tx_level << 16 | uart->rx_level;
+        case 7:
+            return uart->tx_threshold << 16 | uart->rx_threshold;
+        default:
+            return 0;
+    }
+}
+
+static void uart_write(Sim* sim, SimDevice* device, uint32_t addr, uint32_t wdata, uint32_t wstrb) {
+    SimUart* uart = device->context;
+    (void)wstrb;
+    switch ((addr >> 2) & 7) {
+        case 0:
+            // Dropped when the TX FIFO is full
+            if (uart->tx_level < SIM_UART_FIFO_DEPTH) {
+                uart->tx_fifo[(uart->tx_head + uart->tx_level) % SIM_UART_FIFO_DEPTH] = (uint8_t)wdata;
+                uart->tx_level++;
+                uart_tx_start(sim, uart);
+            }
+            break;
+        case 4:
+            uart->irq_enable = wdata & 3;
+            break;
+        case 5:
+            // Like uart.v, divisors below 2 are ignored
+            if ((wdata & 0xFFFF) >= 2)
+                uart->divisor = wdata & 0xFFFF;
+            break;
+        case 7:
+            uart->rx_threshold = wdata & 0xFFFF;
+            uart->tx_threshold = wdata >> 16;
+            break;
+    }
+    uart_update(sim, uart);
+}
+
+static void uart_event(Sim* sim, SimDevice* device) {
+    SimUart* uart = device->context;
+    if (uart->tx_shifting && uart->tx_done_cycle <= sim->cycle) {
+        uart->tx_shifting = 0;
+        if (uart->tx_byte)
+            uart->tx_byte(sim, uart->tx_context, uart->tx_shift);
+        uart_tx_start(sim, uart);
+    }
+    if (uart->rx_next_cycle <= sim->cycle) {
+        uart->rx_fifo[(uart->rx_head + uart->rx_level) % SIM_UART_FIFO_DEPTH] = uart->rx_data[uart->rx_index++];
+        uart->rx_level++;
+        uart->rx_next_cycle = SIM_NEVER;
+        uart_rx_schedule(sim, uart);
+    }
+    uart_update(sim, uart);
+}
+
+void sim_uart_init(SimUart* uart, uint32_t divisor) {
+    memset(uart, 0, sizeof(*uart));
+    uart->device.name = "uart";
+    uart->device.context = uart;
+    uart->device.read = uart_read;
+    uart->device.write = uart_write;
+    uart->device.event = uart_event;
+    uart->device.event_cycle = SIM_NEVER;
+    uart->divisor = divisor;
+    uart->rx_threshold = 1;
+    uart->rx_next_cycle = SIM_NEVER;
+}
+
+void sim_uart_set_rx(SimUart* uart, Sim* sim, const uint8_t* data, size_t length) {
+    uart->rx_data = data;
+    uart->rx_length = length;
+    uart->rx_index = 0;
+    uart->rx_next_cycle = SIM_NEVER;
+    uart_rx_schedule(sim, uart);
+    uart_update(sim, uart);
+    sim_update_events(sim);
+}
+
+void sim_uart_release_rx(SimUart* uart, Sim* sim, size_t length) {
+    uart->rx_length = length;
+    uart_rx_schedule(sim, uart);
+    uart_update(sim, uart);
+    sim_update_events(sim);
+}
+
+// === Timer ===
+
+static void timer_update(Sim* sim, SimTimer* timer) {
+    uint64_t mtime = sim->cycle - timer->mtime_base;
+    int irq = mtime >= timer->mtimecmp;
+    sim_set_irq(sim, SIM_IRQ_TIMER, irq);
+    uint64_t remaining = timer->mtimecmp - mtime;
+    timer->device.event_cycle = irq || remaining > SIM_NEVER - sim->cycle ? SIM_NEVER : sim->cycle + remaining;
+}
+
+static uint32_t timer_read(Sim* sim, SimDevice* device, uint32_t addr) {
+    SimTimer* timer = device->context;
+    uint64_t value = ((addr >> 3) & 1) ? timer->mtimecmp : sim->cycle - timer->mtime_base;
+    return ((addr >> 2) & 1) ? (uint32_t)(value >> 32) : (uint32_t)value;
+}
+
+static void timer_write(Sim* sim, SimDevice* device, uint32_t addr, uint32_t wdata, uint32_t wstrb) {
+    SimTimer* timer = device->context;
+    (void)wstrb;
+    int high = (addr >> 2) & 1;
+    uint64_t* value = NULL;
+    uint64_t mtime = sim->cycle - timer->mtime_base;
+    if ((addr >> 3) & 1)
+        value = &timer->mtimecmp;
+    else
+        value = &mtime;
+    *value = high ? (*value & 0xFFFFFFFFu) | (uint64_t)wdata << 32 : (*value & ~(uint64_t)0xFFFFFFFFu) | wdata;
+    timer->mtime_base = sim->cycle - mtime;
+    timer_update(sim, timer);
+}
+
+static void timer_event(Sim* sim, SimDevice* device) {
+    timer_update(sim, device->context);
+}
+
+void sim_timer_init(SimTimer* timer) {
+    memset(timer, 0, sizeof(*timer));
+    timer->device.name = "timer";
+    timer->device.context = timer;
+    timer->device.read = timer_read;
+    timer->device.write = timer_write;
+    timer->device.event = timer_event;
+    timer->device.event_cycle = SIM_NEVER;
+    timer->mtimecmp = UINT64_MAX;
+}
+
+// === LEDs ===
+
+static uint32_t led_read(Sim* sim, SimDevice* device, uint32_t addr) {
+    (void)sim;
+    (void)addr;
+    return ((SimLed*)device->context)->value;
+}
+
+static void led_write(Sim* sim, SimDevice* device, uint32_t addr, uint32_t wdata, uint32_t wstrb) {
+    (void)sim;
+    (void)addr;
+    (void)wstrb;
+    ((SimLed*)device->context)->value = wdata & 0x3F;
+}
+
+void sim_led_init(SimLed* led) {
+    memset(led, 0, sizeof(*led));
+    led->device.name = "led";
+    led->device.context = led;
+    led->device.read = led_read;
+    led->device.write = led_write;
+    led->device.event_cycle = SIM_NEVER;
+}
+
+// === Taro ===
+
+static uint32_t taro_device_read(Sim* sim, SimDevice* device, uint32_t addr) {
+    (void)sim;
+    return taro_read(((SimTaro*)device->context)->taro, (addr & (TARO_WINDOW - 1)) >> 2);
+}
+
+static void taro_device_write(Sim* sim, SimDevice* device, uint32_t addr, uint32_t wdata, uint32_t wstrb) {
+    (void)sim;
+    taro_write(((SimTaro*)device->context)->taro, (addr & (TARO_WINDOW - 1)) >> 2, wdata, wstrb);
+}
+
+void sim_taro_init(SimTaro* device, Taro* taro) {
+    memset(device, 0, sizeof(*device));
+    device->device.name = "taro";
+    device->device.context = device;
+    device->device.read = taro_device_read;
+    device->device.write = taro_device_write;
+    device->device.event_cycle = SIM_NEVER;
+    device->taro = taro;
+}
+
+int sim_taro_map(SimTaro* device, Sim* sim, uint32_t base) {
+    if (sim_map_device(sim, base, TARO_WINDOW, &device->device) != 0)
+        return -1;
+    // Each text word is {odd cell, even cell}, the little-endian layout of cells[]
+    uint32_t direct_size = (TARO_TEXT_WORDS * 4) & ~SIM_PAGE_MASK;
+    sim_map_memory(sim, base, direct_size, (uint8_t*)device->taro->cells, direct_size, SIM_READ);
+    return 0;
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Host simulator models of the fpga/top.v devices, each a SimDevice plug-in
+// (see sim_core.h). The SimDevice is the first member so a device can be
+// mapped with &model.device.
+//   SimUart  - uart.v register map with 256-byte FIFOs; bytes take ten bit
+//              times of the programmed divisor in both directions
+//   SimTimer - timer.v mtime and mtimecmp, driving the timer interrupt
+//   SimLed   - the 6-bit LED register
+//   SimTaro  - Taro text RAM and registers on a host Taro model; text RAM
+//              loads go straight to the cells, stores go through taro_write
+
+#ifndef SIM_DEVICES_H
+#define SIM_DEVICES_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#include "sim_core.h"
+#include "taro.h"
+
+#define SIM_UART_FIFO_DEPTH 256
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct SimUart {
+    SimDevice device;
+    uint32_t divisor;
+    uint32_t irq_enable;
+    uint32_t rx_threshold, tx_threshold;
+
+    uint8_t tx_fifo[SIM_UART_FIFO_DEPTH];
+    uint32_t tx_head, tx_level;
+    int tx_shifting;
+    uint8_t tx_shift;
+    uint64_t tx_done_cycle;
+    // Called with every byte once its stop bit has been sent
+    void (*tx_byte)(Sim* sim, void* context, uint8_t byte);
+    void* tx_context;
+
+    // The RX line sends rx_data back to back while the RX FIFO has room
+    uint8_t rx_fifo[SIM_UART_FIFO_DEPTH];
+    uint32_t rx_head, rx_level;
+    const uint8_t* rx_data;
+    size_t rx_length, rx_index;
+    uint64_t rx_next_cycle;  // SIM_NEVER while the FIFO is full or the input is done
+} SimUart;
+
+typedef struct SimTimer {
+    SimDevice device;
+    uint64_t mtime_base;  // mtime is sim->cycle - mtime_base
+    uint64_t mtimecmp;
+} SimTimer;
+
+typedef struct SimLed {
+    SimDevice device;
+    uint32_t value;
+} SimLed;
+
+typedef struct SimTaro {
+    SimDevice device;
+    Taro* taro;
+} SimTaro;
+
+// divisor is the reset baud divisor in clock cycles per bit
+void sim_uart_init(SimUart* uart, uint32_t divisor);
+// Queue bytes for the RX line, starting one character time from now
+void sim_uart_set_rx(SimUart* uart, Sim* sim, const uint8_t* data, size_t length);
+// Let the RX line go on to the first length bytes of the data, for RX that
+// was held back
+void sim_uart_release_rx(SimUart* uart, Sim* sim, size_t length);
+
+void sim_timer_init(SimTimer* timer);
+void sim_led_init(SimLed* led);
+
+// Map the text RAM and registers at base; loads from the pages that hold
+// only text RAM read the cells directly
+void sim_taro_init(SimTaro* device, Taro* taro);
+int sim_taro_map(SimTaro* device, Sim* sim, uint32_t base);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
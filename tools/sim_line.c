@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Simulator command-line and UART line helpers, see sim_line.h
+
+#include "sim_line.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+// Expand \r, \n, \t, \\ and \xNN escapes in command-line strings
+static int unescape(char* dest, int capacity, const char* src) {
+    int length = 0;
+    while (*src && length < capacity) {
+        if (*src == '\\' && src[1]) {
+            src++;
+            switch (*src) {
+                case 'r':
+                    dest[length++] = '\r';
+                    break;
+                case 'n':
+                    dest[length++] = '\n';
+                    break;
+                case 't':
+                    dest[length++] = '\t';
+                    break;
+                case 'x': {
+                    char hex[3] = {0};
+                    strncpy(hex, src + 1, 2);
+                    dest[length++] = (char)strtoul(hex, NULL, 16);
+                    src += strlen(hex);
+                    break;
+                }
+                default:
+                    dest[length++] = *src;
+                    break;
+            }
+            src++;
+        } else {
+            dest[length++] = *src++;
+        }
+    }
+    return length;
+}
+
+void sim_line_init(SimLine* line) {
+    memset(line, 0, sizeof(*line));
+    line->tx_file = stdout;
+}
+
+int sim_line_option(SimLine* line, const char* arg, const char* value) {
+    if (strcmp(arg, "--rx") == 0) {
+        FILE* file = fopen(value, "rb");
+        if (!file) {
+            fprintf(stderr, "Cannot open RX file: %s\n", value);
+            return -1;
+        }
+        line->rx_length += (int)fread(line->rx_bytes + line->rx_length, 1, SIM_LINE_MAX_RX_BYTES - line->rx_length,
+                                      file);
+        fclose(file);
+    } else if (strcmp(arg, "--rx-text") == 0) {
+        line->rx_length +=
+            unescape((char*)line->rx_bytes + line->rx_length, SIM_LINE_MAX_RX_BYTES - line->rx_length, value);
+    } else if (strcmp(arg, "--rx-wait") == 0) {
+        if (line->wait_count == SIM_LINE_MAX_WAITS) {
+            fprintf(stderr, "At most %d --rx-wait options\n", SIM_LINE_MAX_WAITS);
+            return -1;
+        }
+        SimLineWait* wait = &line->waits[line->wait_count++];
+        wait->rx_offset = line->rx_length;
+        wait->length = unescape(wait->text, SIM_LINE_MAX_MATCH_LEN, value);
+    } else if (strcmp(arg, "--tx") == 0) {
+        if (line->tx_file != stdout)
+            fclose(line->tx_file);
+        if (!(line->tx_file = fopen(value, "wb"))) {
+            fprintf(stderr, "Cannot open TX file: %s\n", value);
+            return -1;
+        }
+    } else if (strcmp(arg, "--until") == 0) {
+        line->until_length = unescape(line->until, SIM_LINE_MAX_MATCH_LEN, value);
+    } else {
+        return 0;
+    }
+    return 1;
+}
+
+int sim_line_rx_released(const SimLine* line) {
+    return line->wait_index < line->wait_count ? line->waits[line->wait_index].rx_offset : line->rx_length;
+}
+
+// Whether the TX tail ends with text, within the last count bytes
+static int tail_matches(const SimLine* line, const char* text, int length, int count) {
+    return length > 0 && count >= length && line->tx_tail_length >= length &&
+           memcmp(line->tx_tail + line->tx_tail_length - length, text, length) == 0;
+}
+
+int sim_line_tx(SimLine* line, uint8_t byte) {
+    fputc(byte, line->tx_file);
+    if (line->tx_tail_length == SIM_LINE_MAX_MATCH_LEN) {
+        memmove(line->tx_tail, line->tx_tail + 1, SIM_LINE_MAX_MATCH_LEN - 1);
+        line->tx_tail_length--;
+    }
+    line->tx_tail[line->tx_tail_length++] = (char)byte;
+    if (tail_matches(line, line->until, line->until_length, line->tx_tail_length))
+        line->matched = 1;
+
+    // A wait only matches output that came after the previous one
+    line->wait_tx_count++;
+    if (line->wait_index < line->wait_count) {
+        const SimLineWait* wait = &line->waits[line->wait_index];
+        if (tail_matches(line, wait->text, wait->length, line->wait_tx_count)) {
+            line->wait_index++;
+            line->wait_tx_count = 0;
+        }
+    }
+    return line->matched;
+}
+
+int sim_line_finish(SimLine* line) {
+    fflush(line->tx_file);
+    if (line->tx_file != stdout)
+        fclose(line->tx_file);
+    line->tx_file = stdout;
+    return line->until_length > 0 && !line->matched;
+}
+
+int sim_line_load_hex(const char* path, uint32_t* words, int count) {
+    FILE* file = fopen(path, "r");
+    if (!file)
+        return -1;
+    unsigned int word;
+    int i = 0;
+    while (i < count && fscanf(file, "%x", &word) == 1)
+        words[i++] = word;
+    while (i < count)
+        words[i++] = 0;
+    fclose(file);
+    return 0;
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Command-line and UART line helpers shared by the host simulator (tools/sim.c)
+// and the Verilator harness (fpga/sim/top_sim.cpp): the reset bit time, the
+// bytes sent over RX from --rx and --rx-text, held back by --rx-wait until
+// the reply a host would wait for, the TX output file with the --until match
+// on its tail, and ROM images of hex words.
+
+#ifndef SIM_LINE_H
+#define SIM_LINE_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define SIM_LINE_CLK_FREQ 27000000
+#define SIM_LINE_BAUD_RATE 115200
+#define SIM_LINE_BAUD_TICKS ((SIM_LINE_CLK_FREQ + SIM_LINE_BAUD_RATE / 2) / SIM_LINE_BAUD_RATE)
+#define SIM_LINE_MAX_RX_BYTES (1 << 20)
+#define SIM_LINE_MAX_MATCH_LEN 256
+#define SIM_LINE_MAX_WAITS 8
+
+// Usage lines of the options handled by sim_line_option
+#define SIM_LINE_USAGE                                                                   \
+    "  --rx FILE          send FILE over the UART RX line\n"                             \
+    "  --rx-text STRING   send STRING over the UART RX line (\\r, \\n, \\xNN escapes)\n" \
+    "  --rx-wait STRING   hold the RX bytes given after it until UART TX output ends\n"  \
+    "                     with STRING\n"                                                \
+    "  --tx FILE          write UART TX bytes to FILE instead of stdout\n"               \
+    "  --until STRING     stop successfully once UART TX output ends with STRING\n"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct SimLineWait {
+    int rx_offset;  // first RX byte held back
+    char text[SIM_LINE_MAX_MATCH_LEN];
+    int length;
+} SimLineWait;
+
+typedef struct SimLine {
+    uint8_t rx_bytes[SIM_LINE_MAX_RX_BYTES];
+    int rx_length;
+    SimLineWait waits[SIM_LINE_MAX_WAITS];
+    int wait_count;
+    int wait_index;     // first wait not yet seen on TX
+    int wait_tx_count;  // TX bytes since the previous wait was seen
+
+    FILE* tx_file;
+    char until[SIM_LINE_MAX_MATCH_LEN];
+    int until_length;
+    char tx_tail[SIM_LINE_MAX_MATCH_LEN];
+    int tx_tail_length;
+    int matched;
+} SimLine;
+
+void sim_line_init(SimLine* line);
+// Handle --rx, --rx-text, --rx-wait, --tx and --until: returns 1 when arg is
+// one of them, 0 when it is not and -1 after printing an error
+int sim_line_option(SimLine* line, const char* arg, const char* value);
+// Number of RX bytes the line may send so far: up to the first --rx-wait
+// whose string has not been seen on TX yet
+int sim_line_rx_released(const SimLine* line);
+// Write a byte decoded from the TX line; returns 1 once the output ends with
+// the --until string
+int sim_line_tx(SimLine* line, uint8_t byte);
+// Flush and close the TX file; returns 1 when --until was given but not reached
+int sim_line_finish(SimLine* line);
+
+// Read hex words, one per line, like $readmemh, and clear the rest of words
+int sim_line_load_hex(const char* path, uint32_t* words, int count);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
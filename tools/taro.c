@@ -0,0 +1,212 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+#include "taro.h"
+
+#include <string.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// Same 16-colour palette as the px_r/px_g/px_b lookup in text_mode.v
+static const uint32_t palette[16] = {
+    0x000000, 0x0000AA, 0x00AA00, 0x00AAAA, 0xAA0000, 0xAA00AA, 0xAA5500, 0xAAAAAA,
+    0x555555, 0x5555FF, 0x55FF55, 0x55FFFF, 0xFF5555, 0xFF55FF, 0xFFFF55, 0xFFFFFF,
+};
+
+void taro_init(Taro* taro, const uint8_t* font) {
+    memset(taro->cells, 0, sizeof(taro->cells));
+    if (font)
+        memcpy(taro->font, font, TARO_FONT_SIZE);
+    else
+        memset(taro->font, 0, TARO_FONT_SIZE);
+    taro->origin = 0;
+    taro->blit_src = 0;
+    taro->blit_dst = 0;
+    taro->blit_len = 0;
+    taro->blit_fill = 0;
+    taro->dirty_rows = (UINT64_C(1) << TARO_ROWS) - 1;
+}
+
+int taro_load_font(Taro* taro, const char* path) {
+    FILE* file = fopen(path, "rb");
+    if (!file)
+        return -1;
+    size_t length = fread(taro->font, 1, TARO_FONT_SIZE, file);
+    int extra = fgetc(file);
+    fclose(file);
+    if (length != TARO_FONT_SIZE || extra != EOF)
+        return -1;
+    taro->dirty_rows = (UINT64_C(1) << TARO_ROWS) - 1;
+    return 0;
+}
+
+// Fill or copy whole words like the text_mode.v blitter. Copies with the
+// destination above the source run backwards; words past the end of text RAM
+// are skipped.
+static void taro_blit(Taro* taro, uint32_t op) {
+    int backward = op == TARO_BLIT_COPY && taro->blit_dst > taro->blit_src;
+    for (uint32_t i = 0; i < taro->blit_len; i++) {
+        uint32_t offset = backward ? taro->blit_len - 1 - i : i;
+        uint32_t dst = (taro->blit_dst + offset) & 0xFFF;
+        uint32_t value = taro->blit_fill;
+        if (op == TARO_BLIT_COPY) {
+            uint32_t src = (taro->blit_src + offset) & 0xFFF;
+            value = taro_read(taro, src < TARO_TEXT_WORDS ? src : 0);
+        }
+        if (dst < TARO_TEXT_WORDS)
+            taro_write(taro, dst, value, 0xF);
+    }
+}
+
+void taro_write(Taro* taro, uint32_t word_addr, uint32_t wdata, uint32_t wstrb) {
+    switch (word_addr) {
+        case TARO_BLIT_SRC_WORD:
+            taro->blit_src = wdata & 0xFFF;
+            return;
+        case TARO_BLIT_DST_WORD:
+            taro->blit_dst = wdata & 0xFFF;
+            return;
+        case TARO_BLIT_LEN_WORD:
+            taro->blit_len = wdata & 0xFFF;
+            return;
+        case TARO_BLIT_FILL_WORD:
+            taro->blit_fill = wdata;
+            return;
+        case TARO_BLIT_CTRL_WORD:
+            if ((wdata & 3) == TARO_BLIT_FILL || (wdata & 3) == TARO_BLIT_COPY)
+                taro_blit(taro, wdata & 3);
+            return;
+    }
+
+    // Moving the origin shifts every screen row; out-of-range origins are ignored
+    if (word_addr == TARO_ORIGIN_WORD) {
+        if ((wstrb & 1) && (wdata & 0xFF) < TARO_ROWS && (wdata & 0xFF) != taro->origin) {
+            taro->origin = wdata & 0xFF;
+            taro->dirty_rows = (UINT64_C(1) << TARO_ROWS) - 1;
+        }
+        return;
+    }
+    if (word_addr >= TARO_TEXT_WORDS)
+        return;
+
+    uint32_t mask = 0;
+    for (int lane = 0; lane < 4; lane++) {
+        if (wstrb & (1u << lane))
+            mask |= 0xFFu << (lane * 8);
+    }
+    uint32_t old_word = taro_read(taro, word_addr);
+    uint32_t new_word = (old_word & ~mask) | (wdata & mask);
+    if (new_word == old_word)
+        return;
+
+    taro->cells[word_addr * 2] = new_word & 0xFFFF;
+    taro->cells[word_addr * 2 + 1] = new_word >> 16;
+    // Both cells of a word always share a row because TARO_COLS is even
+    uint32_t text_row = word_addr / (TARO_COLS / 2);
+    taro->dirty_rows |= UINT64_C(1) << ((text_row + TARO_ROWS - taro->origin) % TARO_ROWS);
+}
+
+uint32_t taro_read(const Taro* taro, uint32_t word_addr) {
+    switch (word_addr) {
+        case TARO_ORIGIN_WORD:
+            return taro->origin;
+        case TARO_BLIT_SRC_WORD:
+            return taro->blit_src;
+        case TARO_BLIT_DST_WORD:
+            return taro->blit_dst;
+        case TARO_BLIT_LEN_WORD:
+            return taro->blit_len;
+        case TARO_BLIT_FILL_WORD:
+            return taro->blit_fill;
+    }
+    if (word_addr >= TARO_TEXT_WORDS)
+        return 0;
+    return taro->cells[word_addr * 2] | ((uint32_t)taro->cells[word_addr * 2 + 1] << 16);
+}
+
+// Expand one 8-pixel glyph row: bit 7 is the leftmost pixel, set bits take the
+// foreground colour and clear bits the background colour.
+static void expand_glyph_row(uint32_t* pixels, uint8_t bits, uint32_t fg, uint32_t bg) {
+#if defined(__SSE2__)
+    const __m128i left_bits = _mm_set_epi32(0x10, 0x20, 0x40, 0x80);
+    const __m128i right_bits = _mm_set_epi32(0x01, 0x02, 0x04, 0x08);
+    __m128i row = _mm_set1_epi32(bits);
+    __m128i fg_vec = _mm_set1_epi32((int)fg);
+    __m128i bg_vec = _mm_set1_epi32((int)bg);
+    __m128i left = _mm_cmpeq_epi32(_mm_and_si128(row, left_bits), left_bits);
+    __m128i right = _mm_cmpeq_epi32(_mm_and_si128(row, right_bits), right_bits);
+    _mm_storeu_si128((__m128i*)pixels, _mm_or_si128(_mm_and_si128(left, fg_vec), _mm_andnot_si128(left, bg_vec)));
+    _mm_storeu_si128((__m128i*)(pixels + 4),
+                     _mm_or_si128(_mm_and_si128(right, fg_vec), _mm_andnot_si128(right, bg_vec)));
+#elif defined(__ARM_NEON)
+    static const uint32_t left_bits[4] = {0x80, 0x40, 0x20, 0x10};
+    static const uint32_t right_bits[4] = {0x08, 0x04, 0x02, 0x01};
+    uint32x4_t row = vdupq_n_u32(bits);
+    uint32x4_t fg_vec = vdupq_n_u32(fg);
+    uint32x4_t bg_vec = vdupq_n_u32(bg);
+    vst1q_u32(pixels, vbslq_u32(vtstq_u32(row, vld1q_u32(left_bits)), fg_vec, bg_vec));
+    vst1q_u32(pixels + 4, vbslq_u32(vtstq_u32(row, vld1q_u32(right_bits)), fg_vec, bg_vec));
+#else
+    for (int x = 0; x < TARO_GLYPH_SIZE; x++)
+        pixels[x] = (bits & (0x80 >> x)) ? fg : bg;
+#endif
+}
+
+static void render_row(Taro* taro, int row) {
+    uint32_t* row_pixels = &taro->frame[row * TARO_GLYPH_SIZE * TARO_WIDTH];
+    const uint16_t* cells = &taro->cells[((row + taro->origin) % TARO_ROWS) * TARO_COLS];
+    for (int col = 0; col < TARO_COLS; col++) {
+        uint16_t cell = cells[col];
+        const uint8_t* glyph = &taro->font[(cell & 0xFF) * TARO_GLYPH_SIZE];
+        uint32_t fg = palette[(cell >> 8) & 0xF];
+        uint32_t bg = palette[(cell >> 12) & 0xF];
+        uint32_t* pixels = row_pixels + col * TARO_GLYPH_SIZE;
+        for (int y = 0; y < TARO_GLYPH_SIZE; y++)
+            expand_glyph_row(pixels + y * TARO_WIDTH, glyph[y], fg, bg);
+    }
+}
+
+int taro_render(Taro* taro) {
+    int rendered = 0;
+    uint64_t dirty = taro->dirty_rows;
+    while (dirty) {
+        int row = __builtin_ctzll(dirty);
+        dirty &= dirty - 1;
+        render_row(taro, row);
+        rendered++;
+    }
+    taro->dirty_rows = 0;
+    return rendered;
+}
+
+static int write_rgb_rows(const Taro* taro, FILE* file) {
+    uint8_t line[TARO_WIDTH * 3];
+    for (int y = 0; y < TARO_HEIGHT; y++) {
+        const uint32_t* pixels = &taro->frame[y * TARO_WIDTH];
+        for (int x = 0; x < TARO_WIDTH; x++) {
+            line[x * 3] = pixels[x] >> 16;
+            line[x * 3 + 1] = pixels[x] >> 8;
+            line[x * 3 + 2] = pixels[x];
+        }
+        if (fwrite(line, 1, sizeof(line), file) != sizeof(line))
+            return -1;
+    }
+    return 0;
+}
+
+int taro_write_ppm(const Taro* taro, FILE* file) {
+    if (fprintf(file, "P6\n%d %d\n255\n", TARO_WIDTH, TARO_HEIGHT) < 0)
+        return -1;
+    return write_rgb_rows(taro, file);
+}
+
+int taro_write_rgb(const Taro* taro, FILE* file) {
+    return write_rgb_rows(taro, file);
+}
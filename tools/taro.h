@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Host-side model of the Taro 80x60 text-mode display. Mirrors the CPU view of
+// fpga/taro/text_mode.v: each 32-bit word holds two 16-bit cells ({odd, even}),
+// each cell is {attribute, character} with the foreground colour in the low
+// attribute nibble and the background colour in the high nibble. Word
+// TARO_ORIGIN_WORD is the scroll origin: the text row shown at the top. The
+// blit registers follow it; the model runs a blit as soon as it is started,
+// so the control register never reads busy.
+
+#ifndef TARO_H
+#define TARO_H
+
+#include <stdint.h>
+#include <stdio.h>
+
+#define TARO_COLS 80
+#define TARO_ROWS 60
+#define TARO_CELLS (TARO_COLS * TARO_ROWS)
+#define TARO_TEXT_WORDS (TARO_CELLS / 2)
+#define TARO_ORIGIN_WORD 0xC00
+#define TARO_BLIT_SRC_WORD 0xC01
+#define TARO_BLIT_DST_WORD 0xC02
+#define TARO_BLIT_LEN_WORD 0xC03
+#define TARO_BLIT_FILL_WORD 0xC04
+#define TARO_BLIT_CTRL_WORD 0xC05
+#define TARO_BLIT_FILL 1
+#define TARO_BLIT_COPY 2
+#define TARO_GLYPH_SIZE 8
+#define TARO_WIDTH (TARO_COLS * TARO_GLYPH_SIZE)
+#define TARO_HEIGHT (TARO_ROWS * TARO_GLYPH_SIZE)
+#define TARO_FONT_SIZE 2048
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct Taro {
+    uint16_t cells[TARO_CELLS];
+    uint8_t font[TARO_FONT_SIZE];
+    uint32_t origin;                           // text row shown on screen row 0
+    uint32_t blit_src, blit_dst, blit_len;     // text words
+    uint32_t blit_fill;
+    uint64_t dirty_rows;                       // bit n set when screen row n must be re-rendered
+    uint32_t frame[TARO_HEIGHT * TARO_WIDTH];  // 0x00RRGGBB pixels
+} Taro;
+
+// Clear the text buffer and registers and mark every row dirty. font may be NULL for a blank font.
+void taro_init(Taro* taro, const uint8_t* font);
+
+// Load a raw 256 x 8-byte font. Returns 0 on success.
+int taro_load_font(Taro* taro, const char* path);
+
+// CPU-side word access with byte-lane write strobes, as seen on the SoC bus.
+// Out-of-range writes are ignored and out-of-range reads return zero.
+void taro_write(Taro* taro, uint32_t word_addr, uint32_t wdata, uint32_t wstrb);
+uint32_t taro_read(const Taro* taro, uint32_t word_addr);
+
+// Re-render dirty rows into frame and clear the dirty bitmap.
+// Returns the number of text rows rendered.
+int taro_render(Taro* taro);
+
+// Frame output: a binary PPM image, or one raw RGB24 video frame that can be
+// appended to a stream (ffplay -f rawvideo -pixel_format rgb24 -video_size 640x480).
+// Both return 0 on success.
+int taro_write_ppm(const Taro* taro, FILE* file);
+int taro_write_rgb(const Taro* taro, FILE* file);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
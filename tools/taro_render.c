@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Render a Taro text RAM dump to a 640x480 image
+// The dump uses the $readmemh/$writememh format: one hexadecimal 32-bit word
+// per line in CPU word order, optional @address lines and // comments.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "taro.h"
+
+static Taro taro;
+
+static int load_text_dump(const char* path) {
+    FILE* file = fopen(path, "r");
+    if (!file) {
+        fprintf(stderr, "Cannot open text dump: %s\n", path);
+        return -1;
+    }
+
+    char line[256];
+    int line_number = 0;
+    uint32_t word_addr = 0;
+    while (fgets(line, sizeof(line), file)) {
+        line_number++;
+        char* comment = strstr(line, "//");
+        if (comment)
+            *comment = '\0';
+
+        char* token = strtok(line, " \t\r\n");
+        while (token) {
+            char* end;
+            if (token[0] == '@') {
+                word_addr = (uint32_t)strtoul(token + 1, &end, 16);
+            } else {
+                uint32_t word = (uint32_t)strtoul(token, &end, 16);
+                if (word_addr >= TARO_TEXT_WORDS) {
+                    fprintf(stderr, "%s:%d: Error: word address out of range\n", path, line_number);
+                    fclose(file);
+                    return -1;
+                }
+                taro_write(&taro, word_addr++, word, 0xF);
+            }
+            if (*end != '\0') {
+                fprintf(stderr, "%s:%d: Error: invalid hexadecimal value '%s'\n", path, line_number, token);
+                fclose(file);
+                return -1;
+            }
+            token = strtok(NULL, " \t\r\n");
+        }
+    }
+    fclose(file);
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 4) {
+        fprintf(stderr, "Usage: %s <font.pf> <text.mem> <output.ppm>\n", argv[0]);
+        return 1;
+    }
+
+    taro_init(&taro, NULL);
+    if (taro_load_font(&taro, argv[1]) != 0) {
+        fprintf(stderr, "Cannot load 2048-byte font: %s\n", argv[1]);
+        return 1;
+    }
+    if (load_text_dump(argv[2]) != 0)
+        return 1;
+    taro_render(&taro);
+
+    FILE* fout = fopen(argv[3], "wb");
+    if (!fout) {
+        fprintf(stderr, "Cannot open output file: %s\n", argv[3]);
+        return 1;
+    }
+    int result = taro_write_ppm(&taro, fout);
+    fclose(fout);
+    if (result != 0) {
+        fprintf(stderr, "Cannot write output file: %s\n", argv[3]);
+        return 1;
+    }
+    return 0;
+}
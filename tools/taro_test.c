@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Checks the host Taro renderer against the same vectors as text_mode_tb.v
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "taro.h"
+
+static Taro taro;
+
+static void expect(int condition, const char* msg) {
+    if (!condition) {
+        fprintf(stderr, "taro_test: %s\n", msg);
+        exit(1);
+    }
+}
+
+static void expect_pixel(int x, int y, uint32_t expected) {
+    uint32_t got = taro.frame[y * TARO_WIDTH + x];
+    if (got != expected) {
+        fprintf(stderr, "taro_test: pixel mismatch at (%d,%d): got %06x expected %06x\n", x, y, got, expected);
+        exit(1);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    if (argc != 2) {
+        fprintf(stderr, "Usage: %s <font.pf>\n", argv[0]);
+        return 1;
+    }
+    taro_init(&taro, NULL);
+    expect(taro_load_font(&taro, argv[1]) == 0, "cannot load font");
+    expect(taro_render(&taro) == TARO_ROWS, "initial render did not draw every row");
+
+    // Two adjacent cells and all four byte lanes
+    taro_write(&taro, 0, 0x4CDB1F41, 0xF);
+    expect(taro_read(&taro, 0) == 0x4CDB1F41, "word read mismatch");
+    taro_write(&taro, 0, 0x12345678, 0x5);
+    expect(taro_read(&taro, 0) == 0x4C341F78, "byte lane read mismatch");
+
+    // Restore 'A' and a solid block. Row zero of 'A' is 00111000.
+    taro_write(&taro, 0, 0x4CDB1F41, 0xF);
+    expect(taro_render(&taro) == 1, "only row zero should be dirty");
+    expect_pixel(0, 0, 0x0000AA);
+    expect_pixel(2, 0, 0xFFFFFF);
+    expect_pixel(8, 0, 0xFF5555);
+
+    // Rewriting identical data leaves the row clean
+    taro_write(&taro, 0, 0x4CDB1F41, 0xF);
+    expect(taro_render(&taro) == 0, "unchanged write marked a row dirty");
+
+    // Every foreground and background palette entry
+    static const uint32_t palette[16] = {
+        0x000000, 0x0000AA, 0x00AA00, 0x00AAAA, 0xAA0000, 0xAA00AA, 0xAA5500, 0xAAAAAA,
+        0x555555, 0x5555FF, 0x55FF55, 0x55FFFF, 0xFF5555, 0xFF55FF, 0xFFFF55, 0xFFFFFF,
+    };
+    for (uint32_t color = 0; color < 16; color++) {
+        taro_write(&taro, 1, (color << 8) | 0xDB, 0x3);
+        taro_render(&taro);
+        expect_pixel(16, 0, palette[color]);
+        taro_write(&taro, 1, (color << 12) | 0x20, 0x3);
+        taro_render(&taro);
+        expect_pixel(16, 0, palette[color]);
+    }
+
+    // Out-of-range accesses read zero and cannot alias valid word zero
+    taro_write(&taro, TARO_TEXT_WORDS, 0xDEADBEEF, 0xF);
+    expect(taro_read(&taro, TARO_TEXT_WORDS) == 0, "out-of-range read was not zero");
+    expect(taro_read(&taro, 0) == 0x4CDB1F41, "out-of-range write aliased word zero");
+    expect(taro_render(&taro) == 0, "out-of-range write marked a row dirty");
+
+    // Last framebuffer cell: word 2399, odd half, pixel (639,479)
+    taro_write(&taro, TARO_TEXT_WORDS - 1, 0x0CDB0000, 0xF);
+    expect(taro_render(&taro) == 1, "only the last row should be dirty");
+    expect_pixel(639, 479, 0xFF5555);
+    expect_pixel(0, 0, 0x0000AA);
+
+    // The origin register scrolls whole rows: text row 59 moves to the top
+    // and a write to text row 0 then dirties screen row 1
+    taro_write(&taro, TARO_ORIGIN_WORD, TARO_ROWS - 1, 0xF);
+    expect(taro_read(&taro, TARO_ORIGIN_WORD) == TARO_ROWS - 1, "origin read mismatch");
+    expect(taro_render(&taro) == TARO_ROWS, "origin change did not redraw every row");
+    expect_pixel(639, 7, 0xFF5555);
+    expect_pixel(0, 8, 0x0000AA);
+    taro_write(&taro, 0, 0x4CDB1FDB, 0xF);
+    expect(taro_render(&taro) == 1, "only screen row one should be dirty");
+    expect_pixel(2, 8, 0xFFFFFF);
+    taro_write(&taro, TARO_ORIGIN_WORD, TARO_ROWS, 0xF);
+    expect(taro_read(&taro, TARO_ORIGIN_WORD) == TARO_ROWS - 1, "out-of-range origin was accepted");
+    taro_write(&taro, TARO_ORIGIN_WORD, 0, 0xF);
+    taro_render(&taro);
+    expect_pixel(2, 0, 0xFFFFFF);
+
+    // Blits: a full-screen fill, then overlapping copies in both directions
+    taro_write(&taro, TARO_BLIT_DST_WORD, 0, 0xF);
+    taro_write(&taro, TARO_BLIT_LEN_WORD, TARO_TEXT_WORDS, 0xF);
+    taro_write(&taro, TARO_BLIT_FILL_WORD, 0x07200720, 0xF);
+    taro_write(&taro, TARO_BLIT_CTRL_WORD, TARO_BLIT_FILL, 0xF);
+    expect(taro_read(&taro, TARO_BLIT_CTRL_WORD) == 0, "blit still busy");
+    expect(taro_render(&taro) == TARO_ROWS, "full-screen fill did not dirty every row");
+    expect_pixel(639, 479, 0x000000);
+
+    taro_write(&taro, TARO_BLIT_DST_WORD, 40, 0xF);
+    taro_write(&taro, TARO_BLIT_LEN_WORD, 40, 0xF);
+    taro_write(&taro, TARO_BLIT_FILL_WORD, 0x4CDB1F41, 0xF);
+    taro_write(&taro, TARO_BLIT_CTRL_WORD, TARO_BLIT_FILL, 0xF);
+    taro_write(&taro, 100, 0x0C410C42, 0xF);
+    taro_write(&taro, TARO_BLIT_SRC_WORD, 40, 0xF);
+    taro_write(&taro, TARO_BLIT_DST_WORD, 0, 0xF);
+    taro_write(&taro, TARO_BLIT_LEN_WORD, 80, 0xF);
+    taro_write(&taro, TARO_BLIT_CTRL_WORD, TARO_BLIT_COPY, 0xF);
+    expect(taro_read(&taro, 39) == 0x4CDB1F41, "forward copy mismatch");
+    expect(taro_read(&taro, 59) == 0x07200720, "forward copy mismatch");
+    expect(taro_read(&taro, 60) == 0x0C410C42, "forward copy mismatch");
+    taro_render(&taro);
+    expect_pixel(2, 0, 0xFFFFFF);
+
+    taro_write(&taro, 200, 1, 0xF);
+    taro_write(&taro, 201, 2, 0xF);
+    taro_write(&taro, 202, 3, 0xF);
+    taro_write(&taro, TARO_BLIT_SRC_WORD, 200, 0xF);
+    taro_write(&taro, TARO_BLIT_DST_WORD, 201, 0xF);
+    taro_write(&taro, TARO_BLIT_LEN_WORD, 3, 0xF);
+    taro_write(&taro, TARO_BLIT_CTRL_WORD, TARO_BLIT_COPY, 0xF);
+    expect(taro_read(&taro, 200) == 1 && taro_read(&taro, 201) == 1 && taro_read(&taro, 202) == 2 &&
+               taro_read(&taro, 203) == 3,
+           "backward copy mismatch");
+
+    printf("taro_test: PASS\n");
+    return 0;
+}
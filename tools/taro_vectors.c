@@ -0,0 +1,274 @@
+/*
+ * Copyright (c) 2026 Bastiaan van der Plaat
+ *
+ * SPDX-License-Identifier: MIT
+ */
+
+// Golden vectors for the Taro video testbenches, from C models of the
+// tmds_encoder in hdmi.v (with its running disparity) and of the text_mode.v
+// pixel pipeline.
+//
+// taro_vectors tmds FILE
+//   The vector count, then one {de, ctrl[1:0], din[7:0], symbol[9:0]} line per
+//   symbol. Every disparity state the encoder can reach is entered from a
+//   control period along a shortest path, then every data byte is encoded
+//   from it, followed by a control period that cycles through all four codes.
+//
+// taro_vectors text FONT FILE
+//   TEXT_SCREENS screens that together hold every character/attribute pair.
+//   Each screen is 2400 text words, then one word per cell with the palette
+//   indices of the 8 pixels on one scanline of that cell, pixel x in bits
+//   4x+3:4x. Text row r of screen s is checked on scanline (r + s) % 8,
+//   which covers every row of every glyph.
+//
+// Both models work on whole values at once: the TMDS table encodes all 256
+// bytes with a bit count and a prefix-xor instead of the bit-serial chain,
+// and a span of 8 pixels is one 32-bit word of palette nibbles, selected per
+// pixel with SSE2 or NEON like in taro.c, or from a glyph row spread to a
+// nibble mask otherwise.
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "taro.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+#define TMDS_MAX_VECTORS 65536  // vectors array in tmds_encoder_tb.v
+#define DISPARITY_OFFSET 128    // cnt is an 8-bit signed register
+#define TEXT_SCREENS 14         // ceil(65536 / TARO_CELLS), as in text_mode_tb.v
+#define TEXT_COMBINATIONS 65536
+
+// === TMDS ===
+
+static const uint16_t tmds_control[4] = {0x354, 0x0AB, 0x154, 0x2AB};
+
+// Transition-minimised q_m[8:0] and the number of ones in q_m[7:0] per byte
+static uint16_t tmds_q_m[256];
+static uint8_t tmds_ones[256];
+
+static uint32_t count_ones(uint32_t byte) {
+    byte = byte - ((byte >> 1) & 0x55);
+    byte = (byte & 0x33) + ((byte >> 2) & 0x33);
+    return (byte + (byte >> 4)) & 0x0F;
+}
+
+static void tmds_build_table(void) {
+    for (uint32_t data = 0; data < 256; data++) {
+        uint32_t ones = count_ones(data);
+        uint32_t use_xnor = ones > 4 || (ones == 4 && !(data & 1));
+        // q_m[i] is the xor of data[i:0]; the xnor chain inverts the odd bits
+        uint32_t prefix = data ^ (data << 1);
+        prefix ^= prefix << 2;
+        prefix ^= prefix << 4;
+        uint32_t q_m = ((prefix ^ (use_xnor ? 0xAA : 0)) & 0xFF) | (use_xnor ? 0 : 0x100);
+        tmds_q_m[data] = (uint16_t)q_m;
+        tmds_ones[data] = (uint8_t)count_ones(q_m & 0xFF);
+    }
+}
+
+// One encoder step: returns the 10-bit symbol and updates the disparity
+static uint16_t tmds_encode(int* cnt, int de, uint32_t ctrl, uint32_t data) {
+    if (!de) {
+        *cnt = 0;
+        return tmds_control[ctrl & 3];
+    }
+    uint32_t q_m = tmds_q_m[data];
+    int ones = tmds_ones[data];
+    int zeros = 8 - ones;
+    int q_m8 = (q_m >> 8) & 1;
+    if (*cnt == 0 || ones == zeros) {
+        *cnt += q_m8 ? ones - zeros : zeros - ones;
+        return (uint16_t)((!q_m8) << 9 | q_m8 << 8 | (q_m8 ? q_m & 0xFF : ~q_m & 0xFF));
+    }
+    if ((*cnt > 0 && ones > zeros) || (*cnt < 0 && zeros > ones)) {
+        *cnt += zeros - ones + (q_m8 ? 2 : 0);
+        return (uint16_t)(1 << 9 | q_m8 << 8 | (~q_m & 0xFF));
+    }
+    *cnt += ones - zeros - (q_m8 ? 0 : 2);
+    return (uint16_t)(q_m8 << 8 | (q_m & 0xFF));
+}
+
+static uint32_t tmds_vectors[TMDS_MAX_VECTORS];
+static int tmds_vector_count = 0;
+static int tmds_cnt = 0;
+
+static void tmds_emit(int de, uint32_t ctrl, uint32_t data) {
+    if (tmds_vector_count == TMDS_MAX_VECTORS) {
+        fprintf(stderr, "taro_vectors: more than %d TMDS vectors\n", TMDS_MAX_VECTORS);
+        exit(1);
+    }
+    uint16_t symbol = tmds_encode(&tmds_cnt, de, ctrl, data);
+    tmds_vectors[tmds_vector_count++] = (uint32_t)de << 20 | (ctrl & 3) << 18 | (data & 0xFF) << 10 | symbol;
+}
+
+static int write_tmds(const char* path) {
+    // Shortest data paths from a control period (disparity 0) to every
+    // reachable disparity, breadth first
+    int reached[2 * DISPARITY_OFFSET] = {0};
+    int parent[2 * DISPARITY_OFFSET];
+    uint8_t via[2 * DISPARITY_OFFSET];
+    int queue[2 * DISPARITY_OFFSET];
+    int head = 0, tail = 0;
+    reached[DISPARITY_OFFSET] = 1;
+    parent[DISPARITY_OFFSET] = -1;
+    queue[tail++] = 0;
+    while (head < tail) {
+        int state = queue[head++];
+        for (uint32_t data = 0; data < 256; data++) {
+            int next = state;
+            tmds_encode(&next, 1, 0, data);
+            if (!reached[next + DISPARITY_OFFSET]) {
+                reached[next + DISPARITY_OFFSET] = 1;
+                parent[next + DISPARITY_OFFSET] = state;
+                via[next + DISPARITY_OFFSET] = (uint8_t)data;
+                queue[tail++] = next;
+            }
+        }
+    }
+
+    int states = 0;
+    tmds_emit(0, 0, 0);
+    for (int state = -DISPARITY_OFFSET; state < DISPARITY_OFFSET; state++) {
+        if (!reached[state + DISPARITY_OFFSET])
+            continue;
+        states++;
+        uint8_t path[2 * DISPARITY_OFFSET];
+        int length = 0;
+        for (int s = state; s != 0; s = parent[s + DISPARITY_OFFSET])
+            path[length++] = via[s + DISPARITY_OFFSET];
+        for (uint32_t data = 0; data < 256; data++) {
+            for (int i = length - 1; i >= 0; i--)
+                tmds_emit(1, 0, path[i]);
+            if (tmds_cnt != state) {
+                fprintf(stderr, "taro_vectors: path to disparity %d ends at %d\n", state, tmds_cnt);
+                return -1;
+            }
+            tmds_emit(1, 0, data);
+            tmds_emit(0, (uint32_t)state + data, 0);
+        }
+    }
+
+    FILE* file = fopen(path, "w");
+    if (!file)
+        return -1;
+    fprintf(file, "%06x\n", tmds_vector_count);
+    for (int i = 0; i < tmds_vector_count; i++)
+        fprintf(file, "%06x\n", tmds_vectors[i]);
+    fclose(file);
+    printf("taro_vectors: %d TMDS vectors, %d disparity states x 256 bytes\n", tmds_vector_count, states);
+    return 0;
+}
+
+// === Text mode ===
+
+// Palette indices of the 8 pixels of a glyph row: foreground nibbles where
+// the glyph bit is set (bit 7 is the leftmost pixel), background elsewhere
+static uint32_t text_span(uint8_t glyph_row, uint8_t attr) {
+    uint32_t fg = attr & 0xFu;
+    uint32_t bg = (uint32_t)attr >> 4;
+#if defined(__SSE2__)
+    // Lane x holds the nibble of pixel x already shifted into place, so the
+    // span is the OR of all lanes
+    const __m128i left_bits = _mm_set_epi32(0x10, 0x20, 0x40, 0x80);
+    const __m128i right_bits = _mm_set_epi32(0x01, 0x02, 0x04, 0x08);
+    __m128i row = _mm_set1_epi32(glyph_row);
+    __m128i left = _mm_cmpeq_epi32(_mm_and_si128(row, left_bits), left_bits);
+    __m128i right = _mm_cmpeq_epi32(_mm_and_si128(row, right_bits), right_bits);
+    __m128i left_fg = _mm_set_epi32((int)(fg << 12), (int)(fg << 8), (int)(fg << 4), (int)fg);
+    __m128i left_bg = _mm_set_epi32((int)(bg << 12), (int)(bg << 8), (int)(bg << 4), (int)bg);
+    __m128i right_fg = _mm_slli_epi32(left_fg, 16);
+    __m128i right_bg = _mm_slli_epi32(left_bg, 16);
+    __m128i span = _mm_or_si128(_mm_or_si128(_mm_and_si128(left, left_fg), _mm_andnot_si128(left, left_bg)),
+                                _mm_or_si128(_mm_and_si128(right, right_fg), _mm_andnot_si128(right, right_bg)));
+    span = _mm_or_si128(span, _mm_shuffle_epi32(span, 0x4E));
+    span = _mm_or_si128(span, _mm_shuffle_epi32(span, 0xB1));
+    return (uint32_t)_mm_cvtsi128_si32(span);
+#elif defined(__ARM_NEON)
+    static const uint32_t left_bits[4] = {0x80, 0x40, 0x20, 0x10};
+    static const uint32_t right_bits[4] = {0x08, 0x04, 0x02, 0x01};
+    static const int32_t left_shifts[4] = {0, 4, 8, 12};
+    uint32x4_t row = vdupq_n_u32(glyph_row);
+    int32x4_t shifts = vld1q_s32(left_shifts);
+    uint32x4_t left_fg = vshlq_u32(vdupq_n_u32(fg), shifts);
+    uint32x4_t left_bg = vshlq_u32(vdupq_n_u32(bg), shifts);
+    uint32x4_t left = vbslq_u32(vtstq_u32(row, vld1q_u32(left_bits)), left_fg, left_bg);
+    uint32x4_t right = vbslq_u32(vtstq_u32(row, vld1q_u32(right_bits)), vshlq_n_u32(left_fg, 16),
+                                 vshlq_n_u32(left_bg, 16));
+    uint32x4_t span = vorrq_u32(left, right);
+    uint32x2_t half = vorr_u32(vget_low_u32(span), vget_high_u32(span));
+    return vget_lane_u32(half, 0) | vget_lane_u32(half, 1);
+#else
+    uint32_t bits = glyph_row;
+    bits = (bits & 0xF0) >> 4 | (bits & 0x0F) << 4;
+    bits = (bits & 0xCC) >> 2 | (bits & 0x33) << 2;
+    bits = (bits & 0xAA) >> 1 | (bits & 0x55) << 1;
+    // Spread bit x to bit 4x, then widen it to a nibble mask
+    bits = (bits | bits << 12) & 0x000F000F;
+    bits = (bits | bits << 6) & 0x03030303;
+    bits = (bits | bits << 3) & 0x11111111;
+    uint32_t mask = bits * 0xF;
+    return (fg * 0x11111111u & mask) | (bg * 0x11111111u & ~mask);
+#endif
+}
+
+static int write_text(const char* font_path, const char* path) {
+    static Taro taro;
+    taro_init(&taro, NULL);
+    if (taro_load_font(&taro, font_path) != 0) {
+        fprintf(stderr, "taro_vectors: cannot load 2048-byte font: %s\n", font_path);
+        return -1;
+    }
+    FILE* file = fopen(path, "w");
+    if (!file)
+        return -1;
+
+    static uint8_t covered[256][TARO_GLYPH_SIZE];
+    int glyph_rows = 0;
+    for (int screen = 0; screen < TEXT_SCREENS; screen++) {
+        uint16_t cells[TARO_CELLS];
+        for (int cell = 0; cell < TARO_CELLS; cell++) {
+            // Low byte the character, high byte the attribute
+            cells[cell] = (uint16_t)((screen * TARO_CELLS + cell) % TEXT_COMBINATIONS);
+        }
+        for (int word = 0; word < TARO_TEXT_WORDS; word++)
+            fprintf(file, "%08x\n", (uint32_t)cells[word * 2 + 1] << 16 | cells[word * 2]);
+        for (int cell = 0; cell < TARO_CELLS; cell++) {
+            uint8_t character = cells[cell] & 0xFF;
+            int y = (cell / TARO_COLS + screen) % TARO_GLYPH_SIZE;
+            if (!covered[character][y]++)
+                glyph_rows++;
+            fprintf(file, "%08x\n", text_span(taro.font[character * TARO_GLYPH_SIZE + y], cells[cell] >> 8));
+        }
+    }
+    fclose(file);
+    printf("taro_vectors: %d text screens, %d character/attribute pairs, %d of %d glyph rows\n", TEXT_SCREENS,
+           TEXT_COMBINATIONS, glyph_rows, 256 * TARO_GLYPH_SIZE);
+    return glyph_rows == 256 * TARO_GLYPH_SIZE ? 0 : -1;
+}
+
+int main(int argc, char* argv[]) {
+    tmds_build_table();
+    if (argc == 3 && strcmp(argv[1], "tmds") == 0) {
+        if (write_tmds(argv[2]) != 0) {
+            fprintf(stderr, "taro_vectors: cannot write %s\n", argv[2]);
+            return 1;
+        }
+        return 0;
+    }
+    if (argc == 4 && strcmp(argv[1], "text") == 0) {
+        if (write_text(argv[2], argv[3]) != 0) {
+            fprintf(stderr, "taro_vectors: cannot write %s\n", argv[3]);
+            return 1;
+        }
+        return 0;
+    }
+    fprintf(stderr, "Usage: %s tmds FILE | text FONT FILE\n", argv[0]);
+    return 1;
+}
@@ -0,0 +1,67 @@
+; Copyright (c) 2026 Bastiaan van der Plaat
+; SPDX-License-Identifier: MIT
+
+; Reporting for the test ROMs. They count their cases in s0 and jump to
+; test_pass or test_fail with their name in a1; the result is printed by
+; polling the UART, as the ROMs run with interrupts disabled, and the CPU
+; halts:
+;   <name>: PASS
+;   <name>: FAIL case <hex>
+
+test_pass:
+    jal ra, test_puts
+    la a1, str_test_pass
+    jal ra, test_puts
+    j test_halt
+
+test_fail:
+    jal ra, test_puts
+    la a1, str_test_fail
+    jal ra, test_puts
+    srli a0, s0, 4
+    jal ra, test_put_digit
+    andi a0, s0, 15
+    jal ra, test_put_digit
+    la a1, str_test_crlf
+    jal ra, test_puts
+test_halt:
+    wfi
+    j test_halt
+
+; Print the hex digit in a0. Clobbers a0 and t0-t2.
+test_put_digit:
+    addi a0, a0, 48            ; '0'
+    addi t0, zero, 58
+    blt a0, t0, test_putc
+    addi a0, a0, 39            ; 'a' - 10
+    j test_putc
+
+; Print the string at a1. Clobbers a0, a1 and t0-t3.
+test_puts:
+    mv t3, ra
+test_puts_loop:
+    lbu a0, 0(a1)
+    beq a0, zero, test_puts_done
+    jal ra, test_putc
+    addi a1, a1, 1
+    j test_puts_loop
+test_puts_done:
+    jr t3
+
+; Write the byte in a0 to the UART TX FIFO once it has room. Clobbers t1, t2.
+test_putc:
+    li t1, UART_TX_STATUS
+test_putc_wait:
+    lw t2, 0(t1)
+    andi t2, t2, 1
+    bne t2, zero, test_putc_wait
+    li t1, UART_TX_DATA
+    sb a0, 0(t1)
+    ret
+
+str_test_pass:
+    .asciz ": PASS\r\n"
+str_test_fail:
+    .asciz ": FAIL case "
+str_test_crlf:
+    .asciz "\r\n"